@@ -18,6 +18,13 @@ hex <board_size> <pie_rule> <monte_carlo> <processors> <player_color_X> <compute
 <computer_color_O>	color for computer [O]					(default = 12, red)
 <selection_color>	color for active selection background			(default = 8, gray)
 <display_modifs>	YES/NO; display parameters screen on startup		(default = YES)
+<allocation>		UNIFORM/HALVING/COMPARE; Monte Carlo paths allocation	(default = UNIFORM)
+			UNIFORM: every possible move gets the same number of paths
+			HALVING: successive halving, dominated moves are dropped early
+			COMPARE: play HALVING, and count how often UNIFORM agrees
+<common_random>		YES/NO; assess all moves on the same random fills	(default = NO)
+<workers>		NO, or comma separated addresses of worker processes	(default = NO)
+			started with: hex WORKER <address> (see README.md)
 
 black		0	gray	8
 dark_blue	1	blue	9
@@ -37,5 +44,5 @@ Update the command line below to change the defaults
 
 :begin
 
-rem 	<board_size> <pie_rule> <symmetry> <first_move> <monte_carlo> <processors> <player_color_X> <computer_color_O> <selection_color> <display_modifs>
-hex	          7        YES        YES            X          5000            6               15                 12                 8               NO
\ No newline at end of file
+rem 	<board_size> <pie_rule> <symmetry> <first_move> <monte_carlo> <processors> <player_color_X> <computer_color_O> <selection_color> <display_modifs> <allocation> <common_random> <workers>
+hex	          7        YES        YES            X          5000            6               15                 12                 8               NO      UNIFORM              NO        NO
\ No newline at end of file
@@ -14,10 +14,13 @@ Compile options:
 g++ -Wall -c "%f" -std=c++11
 
 Link options (with local MinGW implementation):
-g++ -Wall -O3 -o "%e" "%f" -s -std=c++11
+g++ -Wall -O3 -o "%e" "%f" -s -std=c++11 -lws2_32
 
 Link options (for distribution):
-g++ -Wall -O3 -o "%e" "%f" -s -std=c++11 -static-libgcc -static-libstdc++ -static -lwinpthread
+g++ -Wall -O3 -o "%e" "%f" -s -std=c++11 -static-libgcc -static-libstdc++ -static -lwinpthread -lws2_32
+
+Linux (server mode, or game in an ANSI terminal):
+g++ -Wall -O3 -o hex hex.cpp -std=c++11 -pthread
 
 */
 
@@ -29,10 +32,44 @@ g++ -Wall -O3 -o "%e" "%f" -s -std=c++11 -static-libgcc -static-libstdc++ -stati
 #include <thread>
 #include <future>
 #include <ctime>
-#include <algorithm>  // random_shuffle()
-#include <numeric>    // accumulate()
+#include <algorithm>  // shuffle(), sort(), count()
+#include <random>     // mt19937
+#include <cmath>      // sqrt(), ceil(), log2()
+#include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional> // bind()
+#include <sstream>
+#include <chrono>
+#include <cstring>    // memset()
+#include <cstdlib>    // exit()
+#ifdef _WIN32
+#define NOMINMAX      // keep std::min() and std::max()
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600 // getaddrinfo()
+#endif
+#include <winsock2.h> // sockets (server mode), must be included before windows.h
+#include <ws2tcpip.h> // getaddrinfo()
 #include <conio.h>    // _getch()
 #include <windows.h>  // Windows specific display
+#else
+#include <termios.h>  // _getch() emulation
+#include <unistd.h>
+#include <cerrno>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>      // getaddrinfo()
+#include <fcntl.h>      // non-blocking connect
+#include <sys/stat.h>   // lstat()
+#endif
 
 enum class piece:char {EMPTY, X, O};
 // X must link East and West
@@ -50,6 +87,32 @@ piece FIRST_PLAYER = piece::X; // first player makes first move
 int NUMBER_PROCESSOR = 2; // number of processor to use for parallel threading
 int NUMBER_MONTE_CARLO_PATH = 3000 / NUMBER_PROCESSOR; // number of Monte Carlo path per 1 thread
 
+enum class allocation:char {UNIFORM, HALVING, COMPARE};
+// UNIFORM: every candidate move gets NUMBER_MONTE_CARLO_PATH paths
+// HALVING: successive halving with confidence bound elimination, within the same total budget
+// COMPARE: play the HALVING move, but also run UNIFORM to count how often both choices agree
+allocation MOVE_ALLOCATION = allocation::UNIFORM;
+#define HALVING_CONFIDENCE 3.0 // width of the confidence bound (in standard deviations) to drop a dominated move
+bool COMMON_RANDOM = false; // true: all the moves of a computer turn are assessed against the same random fill orders
+
+// server mode: many games share one pool of NUMBER_PROCESSOR threads
+int MAX_SESSIONS = 16; // admission control: maximum number of simultaneous games
+int MAX_CONNECTIONS = 32; // admission control: maximum number of simultaneous connections to the server
+#define MAX_WORKER_CONNECTIONS 8 // maximum number of simultaneous connections to a worker process
+#define PATH_BATCH 64 // a worker checks every PATH_BATCH paths that its coordinator still waits for the chunk
+double SESSION_TIME_BUDGET = 10.; // seconds of search per computer move (the first round is always completed)
+#define SERVER_ROUNDS 4 // number of rounds sharing the Monte Carlo paths of a computer move
+#define LATENCY_WINDOW 1000 // number of last moves in the latency percentiles of the server
+
+// distributed paths: worker processes (local or remote) play the paths instead of the local threads
+std::vector<std::string> PLAYOUT_WORKERS; // addresses of the worker processes, none to use the local threads
+#define WORKER_DEADLINE 10. // seconds for the workers to play the paths of the first assessment, then the missing paths are played locally
+#define WORKER_DEADLINE_FACTOR 4. // next assessments: deadline = WORKER_DEADLINE_FACTOR times their expected time from the chunks completed so far,
+#define WORKER_DEADLINE_FLOOR 0.5 // and at least WORKER_DEADLINE_FLOOR seconds
+#define WORKER_SUSPENDED_RUNS 20 // a worker lost, unreachable or late at the deadline is left out of the next WORKER_SUSPENDED_RUNS assessments
+#define REDISPATCH_FACTOR 3. // a chunk running for REDISPATCH_FACTOR times the typical chunk time is also sent to an idle worker
+#define WORKER_CONNECT_TIMEOUT 1. // seconds to connect to a worker process, at most until the deadline
+
 nodenumber BOARD_DIMENSION = BOARD_SIZE * BOARD_SIZE; // total number of squares
 const std::string LEFT_MARGIN = "   "; // left margin for the Hex board display
 
@@ -99,53 +162,87 @@ inline nodenumber transpose_node(const nodenumber n) {
 
 class hexGraph {
 public:
-	// constructor
-	hexGraph() {
-		for(nodenumber i = 0; i < BOARD_SIZE; i++) {
-			for(nodenumber j = 0; j < BOARD_SIZE; j++) {
-				// initializing the node number coordinates_to_node(i, j)
+	// constructor: board of size x size squares (the size of the game by default)
+	hexGraph(const nodenumber size = BOARD_SIZE) : _size(size), _dimension(size * size) {
+		for(nodenumber i = 0; i < _size; i++) {
+			for(nodenumber j = 0; j < _size; j++) {
+				// initializing the node number square(i, j)
 				const node n = node(list_neighbors(i, j), piece::EMPTY);
 				_hexboard.push_back(n);
 			}
 		}
 	}
 	// helper function prototypes
+	std::string get_position() const;
+	bool set_position(const std::string &position);
 	inline bool check_move(const nodenumber square_num) const;
 	inline bool make_move(const nodenumber square_num, const piece p);
 	inline void unmake_move(const nodenumber square_num);
 	bool is_winner(const piece p);
-	void score_move(const int rnd, std::promise<double> *result);
+	std::vector<bool> random_paths(const unsigned int rnd, const int number_path, const nodenumber move, const bool common_random, const std::function<bool()> &stop = nullptr);
+	void score_move(const unsigned int rnd, const int number_path, const nodenumber move, const bool common_random, std::promise<std::vector<bool>> *result);
 	std::set<nodenumber> victory_path(const piece p);
 	void print(const std::set<nodenumber> selection, const piece p) const;
 private:
+	nodenumber _size; // size of the board
+	nodenumber _dimension; // total number of squares
 	std::vector<node> _hexboard; // vector of all the squares of the board
 	// setter
 	inline void set_owner(const nodenumber square_num, const piece p) {_hexboard[square_num].set_owner(p);}
 	// getters
 	inline piece get_owner(const nodenumber square_num) const {return get_node(square_num).get_owner();}
 	inline node get_node(const nodenumber square_num) const {return _hexboard[square_num];}
+	inline nodenumber square(const nodenumber i, const nodenumber j) const {
+		// like coordinates_to_node(), for the size of this board
+		return (i >= 0 and i < _size and j >= 0 and j < _size) ? i * _size + j : _dimension;
+	}
 	// helper function prototypes
 	std::vector<nodenumber> list_neighbors(const nodenumber i, const nodenumber j) const;
 	std::queue<nodenumber> get_node1(const piece p);
 	std::set<nodenumber> get_node2(const piece p);
 	bool find_path(std::queue<nodenumber> Q, std::set<nodenumber> node_to, const piece p) const;
 	std::set<nodenumber> find_victory_path(std::queue<nodenumber> Q, std::set<nodenumber> node_to, const piece p) const;
-	inline void print_piece(const HANDLE std_output, const unsigned int background_color, const unsigned int text_color, const char text) const;
+	inline void print_piece(const unsigned int background_color, const unsigned int text_color, const char text) const;
 };
 
 std::vector<nodenumber> hexGraph::list_neighbors(const nodenumber i, const nodenumber j) const {
 	// return the list of neighbors for the square of coordinates (i,j)
 	nodenumber num;
 	std::vector<nodenumber> list;
-	num = coordinates_to_node(i - 1, j);     if (in_board(num)) {list.push_back(num);}
-	num = coordinates_to_node(i - 1, j + 1); if (in_board(num)) {list.push_back(num);}
-	num = coordinates_to_node(i    , j - 1); if (in_board(num)) {list.push_back(num);}
-	num = coordinates_to_node(i    , j + 1); if (in_board(num)) {list.push_back(num);}
-	num = coordinates_to_node(i + 1, j - 1); if (in_board(num)) {list.push_back(num);}
-	num = coordinates_to_node(i + 1, j);     if (in_board(num)) {list.push_back(num);}
+	num = square(i - 1, j);     if (num < _dimension) {list.push_back(num);}
+	num = square(i - 1, j + 1); if (num < _dimension) {list.push_back(num);}
+	num = square(i    , j - 1); if (num < _dimension) {list.push_back(num);}
+	num = square(i    , j + 1); if (num < _dimension) {list.push_back(num);}
+	num = square(i + 1, j - 1); if (num < _dimension) {list.push_back(num);}
+	num = square(i + 1, j);     if (num < _dimension) {list.push_back(num);}
 	return list;
 }
 
+std::string hexGraph::get_position() const {
+	// board as _dimension characters '.', 'X' or 'O', row after row
+	std::string position;
+	for (nodenumber i = 0; i < _dimension; i++) {
+		const piece p = get_owner(i);
+		position += (p == piece::X) ? 'X' : (p == piece::O) ? 'O' : '.';
+	}
+	return position;
+}
+
+bool hexGraph::set_position(const std::string &position) {
+	// set the board from get_position()
+	// return false if position is not a valid board
+	if (position.size() != _dimension) {return false;}
+	for (nodenumber i = 0; i < _dimension; i++) {
+		switch (position[i]) {
+			case 'X': set_owner(i, piece::X); break;
+			case 'O': set_owner(i, piece::O); break;
+			case '.': set_owner(i, piece::EMPTY); break;
+			default: return false;
+		}
+	}
+	return true;
+}
+
 inline bool hexGraph::check_move(const nodenumber square_num) const {
 	// check if a move if possible
 	// (return false if the square was occupied)
@@ -171,8 +268,8 @@ inline void hexGraph::unmake_move(const nodenumber square_num) {
 bool hexGraph::find_path(std::queue<nodenumber> Q, const std::set<nodenumber> node_set, const piece p) const {
 	// return true is there is a path from Q to node_set
 	if (Q.empty() or node_set.empty()) {return false;}
-	bool visited[BOARD_DIMENSION] = {false};
-	bool target[BOARD_DIMENSION] = {false};
+	bool visited[_dimension] = {false};
+	bool target[_dimension] = {false};
 	for (nodenumber n : node_set) {
 		target[n] = true;
 	}
@@ -192,11 +289,11 @@ std::set<nodenumber> hexGraph::find_victory_path(std::queue<nodenumber> Q, const
 	// return the path from Q to node_set
 	// similar to find_path() but find_path() needs to be optimized for speed so cannot return victory path
 	std::set<nodenumber> path;
-	bool visited[BOARD_DIMENSION] = {false};
-	bool target[BOARD_DIMENSION] = {false};
-	nodenumber parent_node[BOARD_DIMENSION];
-	for (nodenumber i = 0; i < BOARD_DIMENSION; i++) {
-		 parent_node[i] = BOARD_DIMENSION;
+	bool visited[_dimension] = {false};
+	bool target[_dimension] = {false};
+	nodenumber parent_node[_dimension];
+	for (nodenumber i = 0; i < _dimension; i++) {
+		 parent_node[i] = _dimension;
 	 }
 	for (nodenumber n : node_set) {
 		target[n] = true;
@@ -205,7 +302,7 @@ std::set<nodenumber> hexGraph::find_victory_path(std::queue<nodenumber> Q, const
 		nodenumber n = Q.front();
 		if (target[n]) {
 			while (true) {
-				if (n == BOARD_DIMENSION) {break;}
+				if (n == _dimension) {break;}
 				path.insert(n);
 				n = parent_node[n];
 			}
@@ -226,15 +323,15 @@ std::queue<nodenumber> hexGraph::get_node1(const piece p) {
 	std::queue<nodenumber> node1;
 	if (p == piece::O) {
 		// O must link North and South
-		// North: nodes are 1, 2, ..., BOARD_SIZE - 1
-		for (nodenumber i = 0; i < BOARD_SIZE; i++) {
+		// North: nodes are 1, 2, ..., _size - 1
+		for (nodenumber i = 0; i < _size; i++) {
 			if (get_owner(i) == p) {node1.push(i);}
 		}
 	} else if (p == piece::X) {
 		// X must link East and West
-		// East: nodes are 0 * BOARD_SIZE, 1 * BOARD_SIZE, ..., (BOARD_SIZE - 1) * BOARD_SIZE
-		for (nodenumber i = 0; i < BOARD_SIZE; i++) {
-			const nodenumber n = i * BOARD_SIZE;
+		// East: nodes are 0 * _size, 1 * _size, ..., (_size - 1) * _size
+		for (nodenumber i = 0; i < _size; i++) {
+			const nodenumber n = i * _size;
 			if (get_owner(n) == p) {node1.push(n);}
 		}
 	}
@@ -245,16 +342,16 @@ std::set<nodenumber> hexGraph::get_node2(const piece p) {
 	std::set<nodenumber> node2;
 	if (p == piece::O) {
 		// O must link North and South
-		// South: nodes are (BOARD_SIZE - 1) * BOARD_SIZE, (BOARD_SIZE - 1) * BOARD_SIZE + 1, ..., (BOARD_SIZE - 1) * BOARD_SIZE + (BOARD_SIZE - 2)
-		for (nodenumber i = 0; i < BOARD_SIZE; i++) {
-			const nodenumber n = BOARD_DIMENSION - (i + 1);
+		// South: nodes are (_size - 1) * _size, (_size - 1) * _size + 1, ..., (_size - 1) * _size + (_size - 2)
+		for (nodenumber i = 0; i < _size; i++) {
+			const nodenumber n = _dimension - (i + 1);
 			if (get_owner(n) == p) {node2.insert(n);}
 		}
 	} else if (p == piece::X) {
 		// X must link East and West
-		// West: nodes are 1 * BOARD_SIZE - 1, 2 * BOARD_SIZE - 1, ..., BOARD_SIZE * BOARD_SIZE - 1
-		for (nodenumber i = 0; i < BOARD_SIZE; i++) {
-			const nodenumber n = (i + 1) * BOARD_SIZE - 1;
+		// West: nodes are 1 * _size - 1, 2 * _size - 1, ..., _size * _size - 1
+		for (nodenumber i = 0; i < _size; i++) {
+			const nodenumber n = (i + 1) * _size - 1;
 			if (get_owner(n) == p) {node2.insert(n);}
 		}
 	}
@@ -304,151 +401,294 @@ unsigned int COLOR_O = color_red;
 unsigned int BACKGROUND_SELECT = color_gray;
 const unsigned int BACKGROUND_DEFAULT = color_black;
 
-inline void hexGraph::print_piece(const HANDLE std_output, const unsigned int background_color, const unsigned int text_color, const char text) const {
+#ifdef _WIN32
+inline void console_color(const unsigned int background_color, const unsigned int text_color) {
+	// set the colors of the upcoming text
+	const unsigned short wAttributes = (background_color << 4) | text_color;
+	SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), wAttributes);
+}
+
+inline void console_home() {
+	// set cursor position to (0,0)
+	const HANDLE std_output = GetStdHandle(STD_OUTPUT_HANDLE);
+	const COORD coord = {0, 0};
+	SetConsoleCursorPosition(std_output, coord);
+	// set windows title & no cursor (Microsoft Windows)
+	SetConsoleTitle("Hex by Arnaud");
+	const CONSOLE_CURSOR_INFO cursorInfo = {1, false};
+	SetConsoleCursorInfo(std_output, &cursorInfo);
+}
+
+inline void console_clear() {
+	system("cls");
+}
+#else
+inline void console_color(const unsigned int background_color, const unsigned int text_color) {
+	// ANSI escape codes: Windows colors are intensity/red/green/blue bits, ANSI colors are blue/green/red bits
+	auto ansi = [](const unsigned int color) {
+		return ((color & 4) ? 1 : 0) + ((color & 2) ? 2 : 0) + ((color & 1) ? 4 : 0) + ((color & 8) ? 60 : 0);
+	};
+	std::cout << "\033[" << 30 + ansi(text_color) << ';' << 40 + ansi(background_color) << 'm';
+}
+
+inline void console_home() {
+	// set cursor position to (0,0), set terminal title & no cursor
+	std::cout << "\033[H\033]0;Hex by Arnaud\007\033[?25l";
+}
+
+inline void console_clear() {
+	std::cout << "\033[2J\033[H";
+}
+
+int _getch() {
+	// emulation of Microsoft _getch(): read a key without echo
+	// <Enter> is returned as 13, and arrows as their Windows codes (72, 75, 77, 80)
+	// the game ends when the keyboard input is closed (end of file or read error)
+	termios settings;
+	tcgetattr(STDIN_FILENO, &settings);
+	const termios saved_settings = settings;
+	settings.c_lflag &= ~(ICANON | ECHO);
+	tcsetattr(STDIN_FILENO, TCSANOW, &settings);
+	std::cout.flush();
+	unsigned char key = 0;
+	ssize_t received;
+	do {
+		received = read(STDIN_FILENO, &key, 1);
+	} while (received < 0 and errno == EINTR);
+	if (received != 1) {
+		tcsetattr(STDIN_FILENO, TCSANOW, &saved_settings);
+		std::cout << std::endl;
+		std::exit(0);
+	}
+	int keyboard_input = key;
+	if (keyboard_input == '\n') {
+		keyboard_input = 13;
+	} else if (keyboard_input == 27) {
+		// arrows are sent as <Esc> [ A/B/C/D; a single <Esc> is not followed by anything
+		settings.c_cc[VMIN] = 0;
+		settings.c_cc[VTIME] = 1;
+		tcsetattr(STDIN_FILENO, TCSANOW, &settings);
+		unsigned char sequence[2];
+		if (read(STDIN_FILENO, &sequence[0], 1) == 1 and sequence[0] == '[' and read(STDIN_FILENO, &sequence[1], 1) == 1) {
+			switch (sequence[1]) {
+				case 'A': keyboard_input = 72; break; // Up
+				case 'B': keyboard_input = 80; break; // Down
+				case 'C': keyboard_input = 77; break; // Right
+				case 'D': keyboard_input = 75; break; // Left
+				default: break;
+			}
+		}
+	}
+	tcsetattr(STDIN_FILENO, TCSANOW, &saved_settings);
+	return keyboard_input;
+}
+#endif
+
+inline void hexGraph::print_piece(const unsigned int background_color, const unsigned int text_color, const char text) const {
 	// print text in color
-	unsigned short wAttributes = (background_color << 4) | text_color;
-	SetConsoleTextAttribute(std_output, wAttributes);
+	console_color(background_color, text_color);
 	std::cout << text;
 	// restore white on black
-	wAttributes = (color_black << 4) | color_white;
-	SetConsoleTextAttribute(std_output, wAttributes);
+	console_color(color_black, color_white);
 }
 
 void hexGraph::print(const std::set<nodenumber> selection = {}, const piece winner = piece::EMPTY) const {
-	// print the board (Microsoft Windows)
-	// if selection < BOARD_DIMENSION, the corresponding square is highlighted (for all members of the set)
-	const HANDLE std_output = GetStdHandle(STD_OUTPUT_HANDLE);
+	// print the board
+	// if selection < _dimension, the corresponding square is highlighted (for all members of the set)
 	const unsigned int background_X = (winner == piece::X) ? BACKGROUND_SELECT : BACKGROUND_DEFAULT;
 	const unsigned int background_O = (winner == piece::O) ? BACKGROUND_SELECT : BACKGROUND_DEFAULT;
 	// set cursor position to (0,0)
 	// equivalent of system("cls"); with better graphic effect (no flickering)
 	// but requires the use of functions erase_end_line() and erase_bottom()
-	const COORD coord = {0, 0};
-    SetConsoleCursorPosition(std_output, coord);
-	// set windows titel, default color & no cursor (Microsoft Windows)
-	SetConsoleTitle("Hex by Arnaud");
-	const CONSOLE_CURSOR_INFO cursorInfo = {1, false};
-    SetConsoleCursorInfo(std_output, &cursorInfo);
+	console_home();
+	// default color
 	const unsigned int textcol = color_white;
 	const unsigned int backcol = BACKGROUND_DEFAULT;
-	const unsigned short wAttributes = (backcol << 4) | textcol;
-	SetConsoleTextAttribute(std_output, wAttributes);
+	console_color(backcol, textcol);
 	std::cout << std::endl;
 	std::cout << LEFT_MARGIN << "  ";
-	for(nodenumber i = 0; i < BOARD_SIZE; i++) {
+	for(nodenumber i = 0; i < _size; i++) {
 		std::cout << ' ';
-		print_piece(std_output, background_O, COLOR_O, 'O');
+		print_piece(background_O, COLOR_O, 'O');
 	}
 	std::cout << std::endl;
-	for(nodenumber i = 0; i < BOARD_SIZE; i++) {
+	for(nodenumber i = 0; i < _size; i++) {
 		std::cout << LEFT_MARGIN << std::string(i + 1, ' ');
 		std::cout << ' ';
-		print_piece(std_output, background_X, COLOR_X, 'X');
-		for(nodenumber j = 0; j < BOARD_SIZE; j++) {
+		print_piece(background_X, COLOR_X, 'X');
+		for(nodenumber j = 0; j < _size; j++) {
 			char owner = '.';
 			unsigned int col_txt = textcol;
 			unsigned int col_bck = backcol;
-			if (get_owner(coordinates_to_node(i, j)) == piece::X) {owner = 'X'; col_txt = COLOR_X;}
-			if (get_owner(coordinates_to_node(i, j)) == piece::O) {owner = 'O'; col_txt = COLOR_O;}	
+			if (get_owner(square(i, j)) == piece::X) {owner = 'X'; col_txt = COLOR_X;}
+			if (get_owner(square(i, j)) == piece::O) {owner = 'O'; col_txt = COLOR_O;}	
 			std::cout << ' ';
-			if (selection.find(coordinates_to_node(i, j)) != selection.end()) {
+			if (selection.find(square(i, j)) != selection.end()) {
 				col_bck = BACKGROUND_SELECT;
 			}
-			print_piece(std_output, col_bck, col_txt, owner);
+			print_piece(col_bck, col_txt, owner);
 		}
 		std::cout << ' ';
-		print_piece(std_output, background_X, COLOR_X, 'X');
+		print_piece(background_X, COLOR_X, 'X');
 		std::cout << std::endl;
 	}
 	std::cout << LEFT_MARGIN << "  ";
-	std::cout << std::string(BOARD_SIZE + 1, ' ');
-	for(nodenumber i = 0; i < BOARD_SIZE; i++) {
+	std::cout << std::string(_size + 1, ' ');
+	for(nodenumber i = 0; i < _size; i++) {
 		std::cout << ' ';
-		print_piece(std_output, background_O, COLOR_O, 'O');
+		print_piece(background_O, COLOR_O, 'O');
 	}
 	std::cout << std::endl;
 	std::cout << std::endl;
 }
 
-void hexGraph::score_move(const int rnd, std::promise<double> *result) {
-	// return the score assessed
-	// computer has just played, so it is player's turn
-	srand(rnd);
+std::vector<bool> hexGraph::random_paths(const unsigned int rnd, const int number_path, const nodenumber move, const bool common_random, const std::function<bool()> &stop) {
+	// return the outcome of each path (true if O wins)
+	// computer has just played move, so it is player's turn
+	// stop (if any) is checked every PATH_BATCH paths: when it returns true, the paths are abandoned and the outcome is incomplete
+	std::mt19937 generator(rnd);
 	std::vector<nodenumber> moves;
+	std::vector<bool> empty(_dimension, false);
 	// all possible upcoming moves
-	for (nodenumber i = 0; i < BOARD_DIMENSION; i++) {
+	for (nodenumber i = 0; i < _dimension; i++) {
 		if (_hexboard[i].get_owner() == piece::EMPTY) {
 			moves.push_back(i);
+			empty[i] = true;
 		}
 	}
-	int count_win = 0;
-	for (int i = 0; i < NUMBER_MONTE_CARLO_PATH; i++) {
-		// random play: allocate X, O, ..., X, O, ...
-		// to the list of possible moves randomly shuffled
-		std::random_shuffle(moves.begin(), moves.end());
-		bool player = true;
-		for (nodenumber move : moves) {
-			if (player) {
-				set_owner(move, piece::X);
-			} else {
-				set_owner(move, piece::O);
-			}
-			player = not player;
+	// with common_random, the fill is drawn for the position before move: a shuffle of all the squares,
+	// occupied squares being skipped, so it only depends on the seed
+	std::vector<nodenumber> order;
+	std::vector<nodenumber> slots;
+	if (common_random) {
+		for (nodenumber i = 0; i < _dimension; i++) {
+			order.push_back(i);
+		}
+		empty[move] = true;
+		slots.resize(moves.size() + 1);
+	}
+	std::vector<bool> outcome;
+	for (int i = 0; i < number_path; i++) {
+		if (stop and i % PATH_BATCH == 0 and i > 0 and stop()) {
+			break;
 		}
-		if (is_winner(piece::O)) {
-			count_win++;
+		if (common_random) {
+			// fill of the position before move, O to play: O, X, O, X, ... by slot of the shuffled empty squares;
+			// move keeps its O, and if its slot is an X slot, it swaps with the previous slot (an O slot),
+			// so the fills of two moves sharing the seed only differ around their two squares
+			std::shuffle(order.begin(), order.end(), generator);
+			std::copy_if(order.begin(), order.end(), slots.begin(), [&](const nodenumber n) {return empty[n];});
+			const size_t k = std::find(slots.begin(), slots.end(), move) - slots.begin();
+			if (k % 2 == 1) {
+				std::swap(slots[k], slots[k - 1]);
+			}
+			for (size_t j = 0; j < slots.size(); j++) {
+				if (slots[j] != move) {
+					set_owner(slots[j], (j % 2 == 0) ? piece::O : piece::X);
+				}
+			}
+		} else {
+			// random play: allocate X, O, ..., X, O, ...
+			// to the list of possible moves randomly shuffled
+			std::shuffle(moves.begin(), moves.end(), generator);
+			bool player = true;
+			for (nodenumber square_num : moves) {
+				if (player) {
+					set_owner(square_num, piece::X);
+				} else {
+					set_owner(square_num, piece::O);
+				}
+				player = not player;
+			}
 		}
+		outcome.push_back(is_winner(piece::O));
 	}
-	for (nodenumber move : moves) {
-		set_owner(move, piece::EMPTY);
+	for (nodenumber square_num : moves) {
+		set_owner(square_num, piece::EMPTY);
 	}
-	result->set_value(1. * count_win / NUMBER_MONTE_CARLO_PATH);
+	return outcome;
 }
 
-double assess_move(std::vector<hexGraph> &hex) {
-	// definition of promise/future variables
-	std::promise<double> res_before[NUMBER_PROCESSOR];
-	std::future<double> res_after[NUMBER_PROCESSOR];
-	for (int i = 0; i < NUMBER_PROCESSOR; i++) {
-		res_after[i] = res_before[i].get_future();
-	}
-	std::thread monte_carlo_thread[NUMBER_PROCESSOR];
-	// definition of threads
-	for (int i = 0; i < NUMBER_PROCESSOR; i++) {
-		// it is critical to have different seeds for each thread
-		const int rnd_seed = (1. + i / 10.) * time(0);
-		monte_carlo_thread[i] = std::thread(&hexGraph::score_move, hex[i], rnd_seed, &res_before[i]);
-	}
-	for (int i = 0; i < NUMBER_PROCESSOR; i++) {
-		monte_carlo_thread[i].join();
+void hexGraph::score_move(const unsigned int rnd, const int number_path, const nodenumber move, const bool common_random, std::promise<std::vector<bool>> *result) {
+	// thread entry point of random_paths()
+	result->set_value(random_paths(rnd, number_path, move, common_random));
+}
+
+inline unsigned int chunk_seed(const unsigned int seed, const int chunk) {
+	// seed of the paths of thread (or chunk) number chunk: it is critical to have different seeds for each thread
+	return seed + chunk * 1000003u;
+}
+
+void distributed_paths(const hexGraph &hex, const nodenumber move, const unsigned int seed, const int number_path, std::vector<std::vector<bool>> &out);
+
+double assess_move(const hexGraph &hex, const nodenumber move, const unsigned int seed, const int number_path = NUMBER_MONTE_CARLO_PATH, std::vector<bool> *outcomes = nullptr) {
+	// return the score of move (just played by O), with number_path paths per thread
+	// the outcome of each path is appended to outcomes, thread after thread
+	std::vector<std::vector<bool>> out(NUMBER_PROCESSOR);
+	if (not PLAYOUT_WORKERS.empty()) {
+		// same paths as the threads, played by the worker processes
+		distributed_paths(hex, move, seed, number_path, out);
+	} else {
+		// definition of promise/future variables
+		std::promise<std::vector<bool>> res_before[NUMBER_PROCESSOR];
+		std::future<std::vector<bool>> res_after[NUMBER_PROCESSOR];
+		for (int i = 0; i < NUMBER_PROCESSOR; i++) {
+			res_after[i] = res_before[i].get_future();
+		}
+		std::thread monte_carlo_thread[NUMBER_PROCESSOR];
+		// definition of threads
+		for (int i = 0; i < NUMBER_PROCESSOR; i++) {
+			// each thread plays its own copy of the board
+			monte_carlo_thread[i] = std::thread(&hexGraph::score_move, hex, chunk_seed(seed, i), number_path, move, COMMON_RANDOM, &res_before[i]);
+		}
+		for (int i = 0; i < NUMBER_PROCESSOR; i++) {
+			monte_carlo_thread[i].join();
+		}
+		for (int i = 0; i < NUMBER_PROCESSOR; i++) {
+			out[i] = res_after[i].get();
+		}
 	}
-	std::vector<double> out;
+	long count_win = 0;
 	for (int i = 0; i < NUMBER_PROCESSOR; i++) {
-		out.push_back(res_after[i].get());
+		count_win += std::count(out[i].begin(), out[i].end(), true);
+		if (outcomes != nullptr) {
+			outcomes->insert(outcomes->end(), out[i].begin(), out[i].end());
+		}
 	}
 	// averaging of results
-	const double average = std::accumulate(out.begin(), out.end(), 0.0) / NUMBER_PROCESSOR;
-	return average;
+	return 1. * count_win / (number_path * NUMBER_PROCESSOR);
 }
 
-inline void parallel_make_move(std::vector<hexGraph> &hex, const nodenumber n, const piece p) {
-	// make a move on board
-	for (int i = 0; i < NUMBER_PROCESSOR; i++) {
-		hex[i].make_move(n, p);
-	}
+inline unsigned int playout_seed(const unsigned int turn_seed, const int round, const nodenumber square_num) {
+	// seed of the paths assessing square_num during a round of the computer turn
+	// with COMMON_RANDOM, all the squares of a round share the same seed, so their paths are paired
+	return turn_seed + round * (BOARD_DIMENSION + 1) + (COMMON_RANDOM ? 0 : square_num + 1);
 }
 
-inline void parallel_unmake_move(std::vector<hexGraph> &hex, const nodenumber n) {
-	// unmake a move on board
-	for (int i = 0; i < NUMBER_PROCESSOR; i++) {
-		hex[i].unmake_move(n);
-	}
-}
+struct search_stats {
+	// Monte Carlo paths (all threads) played by the computer, and paths the UNIFORM allocation would have played
+	long last_used = 0;
+	long last_uniform = 0;
+	long game_used = 0;
+	long game_uniform = 0;
+	// COMPARE allocation: computer moves assessed both ways, and how many of them selected the same square
+	int moves_compared = 0;
+	int moves_matched = 0;
+	// last computer move compared with the runner-up move on their shared random fills
+	long paired_fills = 0;
+	long best_only = 0;   // fills won by the selected move and lost by the runner-up
+	long runner_only = 0; // fills won by the runner-up and lost by the selected move
+	// variance of the score difference between the selected move and the runner-up, summed over the game,
+	// for independent paths and for paired paths (their ratio is the ratio of paths needed for the same accuracy)
+	double game_variance_independent = 0.;
+	double game_variance_paired = 0.;
+};
 
 #define LONGEST_LINE 65
 
 inline void erase_end_line() {
 	// print LONGEST_LINE spaces and return to the beginning of the line
+#ifdef _WIN32
 	const HANDLE std_output = GetStdHandle(STD_OUTPUT_HANDLE);
 	CONSOLE_SCREEN_BUFFER_INFO csbiInfo;
     GetConsoleScreenBufferInfo(std_output, &csbiInfo);
@@ -456,6 +696,9 @@ inline void erase_end_line() {
 	if (x < LONGEST_LINE) {
 		std::cout << std::string(LONGEST_LINE - x, ' ');
 	}
+#else
+	std::cout << "\033[K";
+#endif
 	std::cout << std::endl;
 }
 
@@ -466,13 +709,13 @@ inline void erase_bottom() {
 	}
 }
 
-piece play_player_turn(std::vector<hexGraph> &hex, const nodenumber move_O, nodenumber &move_X, const double score_O, bool &pie_rule, bool &pie_rule_was_used, const double time_O) {
+piece play_player_turn(hexGraph &hex, const nodenumber move_O, nodenumber &move_X, const double score_O, bool &pie_rule, bool &pie_rule_was_used, const double time_O, const search_stats &stats) {
 	// Player [X]'s turn
 	if (move_O < BOARD_DIMENSION) {
 		move_X = move_O; // cursor placed on computer's move
 	}
 	while (true) {
-		hex[0].print({move_X});
+		hex.print({move_X});
 		if (move_O < BOARD_DIMENSION) {
 			if (pie_rule_was_used) {
 				std::cout << " Pie rule!";
@@ -482,6 +725,23 @@ piece play_player_turn(std::vector<hexGraph> &hex, const nodenumber move_O, node
 			std::cout << " (score = " << (int) (1000. * score_O) / 10. << "%)";
 			std::cout << " in " << (int) (10. * time_O) / 10. << " seconds";
 			erase_end_line();
+			if (MOVE_ALLOCATION != allocation::UNIFORM and stats.game_uniform > 0) {
+				std::cout << " Paths: " << stats.last_used << " of " << stats.last_uniform;
+				std::cout << " (game saving = " << (int) (1000. * (stats.game_uniform - stats.game_used) / stats.game_uniform) / 10. << "%)";
+				erase_end_line();
+			}
+			if (MOVE_ALLOCATION == allocation::COMPARE) {
+				std::cout << " Same move as uniform allocation: " << stats.moves_matched << "/" << stats.moves_compared;
+				erase_end_line();
+			}
+			if (COMMON_RANDOM and stats.paired_fills > 0) {
+				std::cout << " Paired vs runner-up: +" << stats.best_only << "/-" << stats.runner_only << " on " << stats.paired_fills << " fills";
+				erase_end_line();
+				if (stats.game_variance_independent > 0.) {
+					std::cout << " Paths needed vs independent: " << (int) (1000. * stats.game_variance_paired / stats.game_variance_independent) / 10. << "% (game)";
+					erase_end_line();
+				}
+			}
 		}
 		std::cout << " Player [X]: use <Arrows> to move, <Enter> to select";
 		erase_end_line();
@@ -510,7 +770,7 @@ piece play_player_turn(std::vector<hexGraph> &hex, const nodenumber move_O, node
 				}
 				break;
 			case 13: // Enter
-				if (hex[0].check_move(move_X) or (pie_rule and move_X == move_O)) {
+				if (hex.check_move(move_X) or (pie_rule and move_X == move_O)) {
 					move_done = true;
 				}
 				break;
@@ -525,42 +785,85 @@ piece play_player_turn(std::vector<hexGraph> &hex, const nodenumber move_O, node
 				if (PIE_RULE_SYMMETRY) {
 					move_X = transpose_node(move_X);
 				}
-				parallel_unmake_move(hex, move_O);
+				hex.unmake_move(move_O);
 				pie_rule_was_used = true;
 			}
 			break;
 		}
 	}
-	parallel_make_move(hex, move_X, piece::X);
-	if (hex[0].is_winner(piece::X)) {
+	hex.make_move(move_X, piece::X);
+	if (hex.is_winner(piece::X)) {
 		return piece::X;
 	} else {
 		return piece::EMPTY;
 	}
 }
 
-piece play_computer_turn(std::vector<hexGraph> &hex, nodenumber &move_O, const nodenumber move_X, double &score_O, bool &pie_rule, bool &pie_rule_was_used, const bool play_average) {
+struct assessment {
+	// paths assessing move, just played by O on position: NUMBER_PROCESSOR chunks of number_path paths,
+	// chunk k with the seed chunk_seed(seed, k); the executor appends the outcome of each path, chunk after chunk
+	hexGraph position;
+	nodenumber move;
+	bool pie; // move is the pie rule move: position is the board without the first move of X
+	unsigned int seed;
+	int number_path;
+	std::vector<bool> outcomes;
+};
+
+// plays a batch of assessments: the threads of the game, or the shared pool of the server
+typedef std::function<void(std::vector<assessment> &)> path_executor;
+
+assessment candidate(const hexGraph &board, const nodenumber square_num, const unsigned int seed, const int number_path) {
+	// assessment of the move square_num of O on board
+	assessment a = {board, square_num, false, seed, number_path, {}};
+	a.position.make_move(square_num, piece::O);
+	return a;
+}
+
+void print_assessing(const assessment &a, const nodenumber move_X, const bool pie_rule_was_used) {
+	// display the move being assessed by the computer
+	a.position.print({a.move});
+	if (move_X < BOARD_DIMENSION) {
+		if (pie_rule_was_used) {
+			std::cout << " Pie rule!";
+			erase_end_line();
+		}
+		std::cout << " Player [X] just played";
+		erase_end_line();
+	}
+	if (a.pie) {
+		std::cout << " Computer [O] is assessing pie rule move...";
+	} else {
+		std::cout << " Computer [O] is assessing move...";
+	}
+	erase_end_line();
+	erase_bottom();
+}
+
+nodenumber uniform_best_move(const hexGraph &board, const path_executor &execute, const int number_round, const std::function<bool()> &keep_going, const bool play_average, const unsigned int turn_seed, double &score_O, std::vector<std::vector<bool>> &outcomes) {
+	// assess all possible moves with NUMBER_MONTE_CARLO_PATH paths per chunk each, shared by number_round rounds;
+	// no new round is started once keep_going() is false
+	const int number_path = std::max(1, NUMBER_MONTE_CARLO_PATH / number_round);
+	for (int round = 0; round < number_round; round++) {
+		std::vector<assessment> batch;
+		for (nodenumber square_num = 0; square_num < BOARD_DIMENSION; square_num++) {
+			if (board.check_move(square_num)) {
+				batch.push_back(candidate(board, square_num, playout_seed(turn_seed, round, square_num), number_path));
+			}
+		}
+		execute(batch);
+		for (const assessment &a : batch) {
+			outcomes[a.move].insert(outcomes[a.move].end(), a.outcomes.begin(), a.outcomes.end());
+		}
+		if (not keep_going()) {break;}
+	}
 	nodenumber best_move = BOARD_DIMENSION;
 	nodenumber worse_move = BOARD_DIMENSION;
 	double worse_score = 1.1; // maximum score possible is 1.0
 	score_O = -1.;
-	// assess all possible moves
 	for (nodenumber square_num = 0; square_num < BOARD_DIMENSION; square_num++) {
-		if (hex[0].check_move(square_num)) {
-			parallel_make_move(hex, square_num, piece::O);
-			hex[0].print({square_num});
-			if (move_X < BOARD_DIMENSION) {
-				if (pie_rule_was_used) {
-					std::cout << " Pie rule!";
-					erase_end_line();
-				}
-				std::cout << " Player [X] just played";
-				erase_end_line();
-			}
-			std::cout << " Computer [O] is assessing move...";
-			erase_end_line();
-			erase_bottom();
-			const double s = assess_move(hex);
+		if (not outcomes[square_num].empty()) {
+			const double s = 1. * std::count(outcomes[square_num].begin(), outcomes[square_num].end(), true) / outcomes[square_num].size();
 			 // select largest score square, or for pie rule
 			 // the square of largest score below 0.5 and
 			 // if it doesn't exist, the square of lowest score
@@ -572,53 +875,1287 @@ piece play_computer_turn(std::vector<hexGraph> &hex, nodenumber &move_O, const n
 				worse_score = s;
 				worse_move = square_num;
 			}
-			parallel_unmake_move(hex, square_num);
 		}
 	}
-	if (pie_rule_was_used) {
-		pie_rule_was_used = false;
+	if (best_move == BOARD_DIMENSION) {
+		best_move = worse_move;
+		score_O = worse_score;
+	}
+	return best_move;
+}
+
+nodenumber halving_best_move(const hexGraph &board, const path_executor &execute, const std::function<bool()> &keep_going, double &score_O, long &paths_used, const unsigned int turn_seed, std::vector<std::vector<bool>> &outcomes) {
+	// successive halving of the possible moves:
+	// the uniform budget is split in log2(moves) rounds, and each round shares its budget between the remaining moves;
+	// after each round, the moves whose upper confidence bound is below the lower bound of the best move are dropped,
+	// then only the best half is kept. The search stops as soon as a single move is left, which saves the remaining rounds
+	// (or once keep_going() is false)
+	std::vector<nodenumber> candidates;
+	for (nodenumber square_num = 0; square_num < BOARD_DIMENSION; square_num++) {
+		if (board.check_move(square_num)) {
+			candidates.push_back(square_num);
+		}
+	}
+	const int number_round = std::max(1, (int) std::ceil(std::log2(candidates.size())));
+	const long round_budget = (long) candidates.size() * NUMBER_MONTE_CARLO_PATH / number_round; // per chunk
+	std::vector<long> wins(BOARD_DIMENSION, 0);
+	std::vector<long> paths(BOARD_DIMENSION, 0);
+	auto score = [&](const nodenumber n) {return 1. * wins[n] / paths[n];};
+	auto bound = [&](const nodenumber n) {
+		const double p = score(n);
+		return HALVING_CONFIDENCE * std::sqrt(std::max(p * (1. - p), 1. / paths[n]) / paths[n]);
+	};
+	for (int round = 1; round == 1 or (candidates.size() > 1 and keep_going()); round++) {
+		const int number_path = std::max(1L, round_budget / (long) candidates.size());
+		std::vector<assessment> batch;
+		for (nodenumber square_num : candidates) {
+			// a different seed for each round, so that the batches of a same move are independent
+			batch.push_back(candidate(board, square_num, playout_seed(turn_seed, round, square_num), number_path));
+		}
+		execute(batch);
+		for (const assessment &a : batch) {
+			wins[a.move] += std::count(a.outcomes.begin(), a.outcomes.end(), true);
+			paths[a.move] += a.outcomes.size();
+			paths_used += a.outcomes.size();
+			outcomes[a.move].insert(outcomes[a.move].end(), a.outcomes.begin(), a.outcomes.end());
+		}
+		std::sort(candidates.begin(), candidates.end(), [&](const nodenumber a, const nodenumber b) {return score(a) > score(b);});
+		// drop the moves statistically dominated by the best move
+		const double best_lower_bound = score(candidates[0]) - bound(candidates[0]);
+		candidates.erase(std::remove_if(candidates.begin() + 1, candidates.end(), [&](const nodenumber n) {return score(n) + bound(n) < best_lower_bound;}), candidates.end());
+		// keep the best half
+		candidates.resize((candidates.size() + 1) / 2);
+	}
+	score_O = score(candidates[0]);
+	return candidates[0];
+}
+
+void paired_comparison(const std::vector<std::vector<bool>> &outcomes, const nodenumber best_move, search_stats &stats) {
+	// compare the selected move with the runner-up on the fills they share (same index in outcomes)
+	// the runner-up is the other move with the most paths, then with the most wins
+	auto wins = [&](const nodenumber n) {return std::count(outcomes[n].begin(), outcomes[n].end(), true);};
+	nodenumber runner_up = BOARD_DIMENSION;
+	for (nodenumber n = 0; n < BOARD_DIMENSION; n++) {
+		if (n == best_move or outcomes[n].empty()) {continue;}
+		if (runner_up == BOARD_DIMENSION or outcomes[n].size() > outcomes[runner_up].size()
+			or (outcomes[n].size() == outcomes[runner_up].size() and wins(n) > wins(runner_up))) {
+			runner_up = n;
+		}
 	}
+	stats.paired_fills = 0;
+	stats.best_only = 0;
+	stats.runner_only = 0;
+	if (runner_up == BOARD_DIMENSION) {return;}
+	const long fills = std::min(outcomes[best_move].size(), outcomes[runner_up].size());
+	long best_wins = 0;
+	long runner_wins = 0;
+	for (long k = 0; k < fills; k++) {
+		const bool best = outcomes[best_move][k];
+		const bool runner = outcomes[runner_up][k];
+		if (best) {best_wins++;}
+		if (runner) {runner_wins++;}
+		if (best and not runner) {stats.best_only++;}
+		if (runner and not best) {stats.runner_only++;}
+	}
+	stats.paired_fills = fills;
+	// variance per fill of the score difference:
+	// independent fills add the variance of both moves, paired fills only keep the discordant fills
+	const double p_best = 1. * best_wins / fills;
+	const double p_runner = 1. * runner_wins / fills;
+	const double delta = 1. * (stats.best_only - stats.runner_only) / fills;
+	stats.game_variance_independent += p_best * (1. - p_best) + p_runner * (1. - p_runner);
+	stats.game_variance_paired += 1. * (stats.best_only + stats.runner_only) / fills - delta * delta;
+}
+
+nodenumber search_move(const hexGraph &board, const nodenumber move_X, const bool pie_rule, const bool play_average, const path_executor &execute, const int number_round, const std::function<bool()> &keep_going, const unsigned int turn_seed, double &score_O, bool &pie_rule_used, search_stats &stats) {
+	// computer [O] move on board, shared by the game and the server, which only differ by their path executor;
+	// with pie_rule, the first move of X may be taken instead (pie_rule_used)
+	long paths_uniform = 0;
+	for (nodenumber square_num = 0; square_num < BOARD_DIMENSION; square_num++) {
+		if (board.check_move(square_num)) {
+			paths_uniform += NUMBER_MONTE_CARLO_PATH * NUMBER_PROCESSOR;
+		}
+	}
+	long paths_used = 0;
+	nodenumber best_move;
+	// outcome of each path, per assessed square
+	std::vector<std::vector<bool>> outcomes(BOARD_DIMENSION);
+	// for pie rule, the first move looks for a score just below 0.5, not for the best score: keep uniform assessment
+	if (MOVE_ALLOCATION == allocation::UNIFORM or play_average) {
+		best_move = uniform_best_move(board, execute, number_round, keep_going, play_average, turn_seed, score_O, outcomes);
+		for (const std::vector<bool> &o : outcomes) {
+			paths_used += o.size();
+		}
+	} else {
+		best_move = halving_best_move(board, execute, keep_going, score_O, paths_used, turn_seed, outcomes);
+		// the uniform rerun of COMPARE is skipped once the time is spent
+		if (MOVE_ALLOCATION == allocation::COMPARE and keep_going()) {
+			double score_uniform;
+			std::vector<std::vector<bool>> outcomes_uniform(BOARD_DIMENSION);
+			const nodenumber uniform_move = uniform_best_move(board, execute, number_round, keep_going, play_average, turn_seed, score_uniform, outcomes_uniform);
+			stats.moves_compared++;
+			if (uniform_move == best_move) {
+				stats.moves_matched++;
+			}
+		}
+	}
+	paired_comparison(outcomes, best_move, stats);
 	// assess pie rule
+	pie_rule_used = false;
 	if (pie_rule) {
 		// O move to move_X
-		parallel_unmake_move(hex, move_X);
-		nodenumber move_X_symmetric;
-		if (PIE_RULE_SYMMETRY) {
-			move_X_symmetric = transpose_node(move_X);
-		} else {
-			move_X_symmetric = move_X;
+		const nodenumber move_X_symmetric = (PIE_RULE_SYMMETRY) ? transpose_node(move_X) : move_X;
+		// same seeds & rounds as the uniform assessment (a different position: not part of the paired comparison);
+		// the first round is always played, the next ones only while keep_going()
+		hexGraph position = board;
+		position.unmake_move(move_X);
+		position.make_move(move_X_symmetric, piece::O);
+		const int number_path = std::max(1, NUMBER_MONTE_CARLO_PATH / number_round);
+		std::vector<bool> o;
+		for (int round = 0; round < number_round and (round == 0 or keep_going()); round++) {
+			std::vector<assessment> batch = {{position, move_X_symmetric, true, playout_seed(turn_seed, round, move_X_symmetric), number_path, {}}};
+			execute(batch);
+			o.insert(o.end(), batch[0].outcomes.begin(), batch[0].outcomes.end());
 		}
-		parallel_make_move(hex, move_X_symmetric, piece::O);
-		hex[0].print({move_X_symmetric});		
-		std::cout << " Player [X] just played";
-		erase_end_line();
-		std::cout << " Computer [O] is assessing pie rule move...";
-		erase_end_line();
-		erase_bottom();
-		const double s = assess_move(hex);
-		parallel_unmake_move(hex, move_X_symmetric);
+		const double s = 1. * std::count(o.begin(), o.end(), true) / o.size();
+		paths_used += o.size();
+		paths_uniform += NUMBER_MONTE_CARLO_PATH * NUMBER_PROCESSOR;
 		if (s > score_O) {
 			score_O = s;
 			best_move = move_X_symmetric;
-			pie_rule_was_used = true;
-		} else {
-			parallel_make_move(hex, move_X, piece::X);
+			pie_rule_used = true;
 		}
 	}
-	if (best_move < BOARD_DIMENSION) {
-		move_O = best_move;
-	} else {
-		move_O = worse_move;
-		score_O = worse_score;
+	stats.last_used = paths_used;
+	stats.last_uniform = paths_uniform;
+	stats.game_used += paths_used;
+	stats.game_uniform += paths_uniform;
+	return best_move;
+}
+
+piece play_computer_turn(hexGraph &hex, nodenumber &move_O, const nodenumber move_X, double &score_O, bool &pie_rule, bool &pie_rule_was_used, const bool play_average, search_stats &stats) {
+	// the paths of each assessment are played by the threads of assess_move(), while the board shows the move
+	const bool pie_rule_was_used_by_X = pie_rule_was_used;
+	const path_executor execute = [&](std::vector<assessment> &batch) {
+		for (assessment &a : batch) {
+			print_assessing(a, move_X, pie_rule_was_used_by_X);
+			assess_move(a.position, a.move, a.seed, a.number_path, &a.outcomes);
+		}
+	};
+	move_O = search_move(hex, move_X, pie_rule, play_average, execute, 1, [] {return true;}, time(0), score_O, pie_rule_was_used, stats);
+	if (pie_rule_was_used) {
+		hex.unmake_move(move_X);
 	}
-	parallel_make_move(hex, move_O, piece::O);
-	if (hex[0].is_winner(piece::O)) {
+	hex.make_move(move_O, piece::O);
+	if (hex.is_winner(piece::O)) {
 		return piece::O;
 	} else {
 		return piece::EMPTY;
 	}
 }
 
+#ifdef _WIN32
+typedef SOCKET socket_t;
+#else
+typedef int socket_t;
+#define INVALID_SOCKET -1
+#define closesocket close
+#endif
+
+void socket_startup() {
+	// initialize the sockets
+#ifdef _WIN32
+	WSADATA wsa_data;
+	WSAStartup(MAKEWORD(2, 2), &wsa_data);
+#else
+	// a peer closing its connection must not stop the process
+	signal(SIGPIPE, SIG_IGN);
+#endif
+}
+
+inline void socket_nodelay(const socket_t s) {
+	// send the short request & reply lines without delay (no effect on Unix domain sockets)
+	const int yes = 1;
+	setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char *) &yes, sizeof(yes));
+}
+
+inline void socket_blocking(const socket_t s, const bool blocking) {
+	// blocking or non-blocking calls on s
+#ifdef _WIN32
+	u_long non_blocking = (blocking) ? 0 : 1;
+	ioctlsocket(s, FIONBIO, &non_blocking);
+#else
+	const int flags = fcntl(s, F_GETFL, 0);
+	fcntl(s, F_SETFL, (blocking) ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK));
+#endif
+}
+
+bool socket_connect(const socket_t s, const sockaddr *addr, const int length, const int milliseconds) {
+	// connect s to addr, waiting at most milliseconds (no limit if milliseconds < 0)
+	if (milliseconds < 0) {return (connect(s, addr, length) == 0);}
+	socket_blocking(s, false);
+	bool ok = (connect(s, addr, length) == 0);
+#ifdef _WIN32
+	const bool in_progress = (not ok and WSAGetLastError() == WSAEWOULDBLOCK);
+#else
+	const bool in_progress = (not ok and errno == EINPROGRESS);
+#endif
+	if (in_progress) {
+		// the connection is done (or failed) when s is ready for writing
+		fd_set ready;
+		fd_set failed;
+		FD_ZERO(&ready);
+		FD_ZERO(&failed);
+		FD_SET(s, &ready);
+		FD_SET(s, &failed);
+		timeval timeout = {milliseconds / 1000, (milliseconds % 1000) * 1000};
+		if (select((int) s + 1, nullptr, &ready, &failed, &timeout) > 0) {
+			int error = 0;
+			socklen_t size = sizeof(error);
+			ok = (getsockopt(s, SOL_SOCKET, SO_ERROR, (char *) &error, &size) == 0 and error == 0);
+		}
+	}
+	socket_blocking(s, true);
+	return ok;
+}
+
+socket_t socket_open(const std::string &address, const bool listening, const int milliseconds = -1) {
+	// address is a TCP port number on the local host, a TCP <host>:<port> (<host> may be a name, an IPv4 address,
+	// an IPv6 address in brackets, or empty for all the interfaces), or unix:<path> for a Unix domain socket (not on Windows)
+	// return a listening socket (listening = true) or a connected socket, INVALID_SOCKET on failure
+	// a connection waits at most milliseconds (no limit if milliseconds < 0)
+	const size_t colon = address.rfind(':');
+	std::string host;
+	std::string port;
+	if (address.compare(0, 5, "unix:") == 0) {
+#ifdef _WIN32
+		return INVALID_SOCKET;
+#else
+		const std::string path = address.substr(5);
+		sockaddr_un address_unix;
+		std::memset(&address_unix, 0, sizeof(address_unix));
+		if (path.empty() or path.size() >= sizeof(address_unix.sun_path)) {return INVALID_SOCKET;}
+		address_unix.sun_family = AF_UNIX;
+		std::strcpy(address_unix.sun_path, path.c_str());
+		if (listening) {
+			// only replace the socket of a previous run, never another file
+			struct stat status;
+			if (lstat(path.c_str(), &status) == 0) {
+				if (not S_ISSOCK(status.st_mode)) {return INVALID_SOCKET;}
+				unlink(path.c_str());
+			}
+		}
+		const socket_t s = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (s == INVALID_SOCKET) {return s;}
+		bool ok;
+		if (listening) {
+			ok = (bind(s, (const sockaddr *) &address_unix, sizeof(address_unix)) == 0 and listen(s, SOMAXCONN) == 0);
+		} else {
+			ok = socket_connect(s, (const sockaddr *) &address_unix, sizeof(address_unix), milliseconds);
+		}
+		if (not ok) {
+			closesocket(s);
+			return INVALID_SOCKET;
+		}
+		return s;
+#endif
+	} else if (not address.empty() and address.find_first_not_of("0123456789") == std::string::npos) {
+		host = "127.0.0.1";
+		port = address;
+	} else if (colon != std::string::npos and address.find('/') == std::string::npos) {
+		host = address.substr(0, colon);
+		port = address.substr(colon + 1);
+		if (host.size() >= 2 and host.front() == '[' and host.back() == ']') {
+			host = host.substr(1, host.size() - 2);
+		}
+		if (port.empty()) {return INVALID_SOCKET;}
+	} else {
+		return INVALID_SOCKET;
+	}
+	addrinfo hints;
+	std::memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = (listening) ? AI_PASSIVE : 0;
+	addrinfo *found;
+	if (getaddrinfo((host.empty()) ? nullptr : host.c_str(), port.c_str(), &hints, &found) != 0) {return INVALID_SOCKET;}
+	// first address of host that works
+	socket_t s = INVALID_SOCKET;
+	for (addrinfo *a = found; a != nullptr and s == INVALID_SOCKET; a = a->ai_next) {
+		s = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+		if (s == INVALID_SOCKET) {continue;}
+		bool ok;
+		if (listening) {
+			const int yes = 1;
+			setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char *) &yes, sizeof(yes));
+			ok = (bind(s, a->ai_addr, (int) a->ai_addrlen) == 0 and listen(s, SOMAXCONN) == 0);
+		} else {
+			ok = socket_connect(s, a->ai_addr, (int) a->ai_addrlen, milliseconds);
+			if (ok) {socket_nodelay(s);}
+		}
+		if (not ok) {
+			closesocket(s);
+			s = INVALID_SOCKET;
+		}
+	}
+	freeaddrinfo(found);
+	return s;
+}
+
+bool send_line(const socket_t s, const std::string &line) {
+	// send one line of text, return false if the connection is lost
+	const std::string data = line + '\n';
+	size_t sent = 0;
+	while (sent < data.size()) {
+		const int n = send(s, data.c_str() + sent, (int) (data.size() - sent), 0);
+		if (n <= 0) {return false;}
+		sent += n;
+	}
+	return true;
+}
+
+int receive_line_wait(const socket_t s, std::string &buffer, std::string &line, const int milliseconds) {
+	// receive one line of text, waiting at most milliseconds for data (no limit if milliseconds < 0)
+	// return 1 if a line was received, 0 on timeout, -1 if the connection is lost
+	// buffer keeps what was received after the line, and must be kept between calls
+	while (true) {
+		const size_t end = buffer.find('\n');
+		if (end != std::string::npos) {
+			line = buffer.substr(0, end);
+			buffer.erase(0, end + 1);
+			if (not line.empty() and line.back() == '\r') {line.pop_back();}
+			return 1;
+		}
+		if (milliseconds >= 0) {
+			fd_set ready;
+			FD_ZERO(&ready);
+			FD_SET(s, &ready);
+			timeval timeout = {milliseconds / 1000, (milliseconds % 1000) * 1000};
+			const int n = select((int) s + 1, &ready, nullptr, nullptr, &timeout);
+			if (n == 0) {return 0;}
+			if (n < 0) {return -1;}
+		}
+		char data[4096];
+		const int n = recv(s, data, sizeof(data), 0);
+		if (n <= 0) {return -1;}
+		buffer.append(data, n);
+	}
+}
+
+inline bool receive_line(const socket_t s, std::string &buffer, std::string &line) {
+	// receive one line of text, return false if the connection is lost
+	return (receive_line_wait(s, buffer, line, -1) == 1);
+}
+
+bool socket_closed(const socket_t s) {
+	// check without waiting if the other end has closed the connection (or if it is lost)
+	fd_set ready;
+	FD_ZERO(&ready);
+	FD_SET(s, &ready);
+	timeval timeout = {0, 0};
+	const int n = select((int) s + 1, &ready, nullptr, nullptr, &timeout);
+	if (n == 0) {return false;}
+	if (n < 0) {return true;}
+	char data;
+	return (recv(s, &data, 1, MSG_PEEK) <= 0);
+}
+
+double percentile(std::vector<double> values, const double p) {
+	// return the p-th percentile (0 <= p <= 1) of values, 0 if there is no value
+	if (values.empty()) {return 0.;}
+	std::sort(values.begin(), values.end());
+	return values[(size_t) (p * (values.size() - 1) + 0.5)];
+}
+
+std::string latency_percentiles(const std::vector<double> &latency) {
+	// latency percentiles in milliseconds
+	std::ostringstream out;
+	out << "p50=" << (long) percentile(latency, 0.5) << "ms";
+	out << " p90=" << (long) percentile(latency, 0.9) << "ms";
+	out << " p99=" << (long) percentile(latency, 0.99) << "ms";
+	return out.str();
+}
+
+std::string latency_summary(const std::vector<double> &latency) {
+	// number of moves & latency percentiles in milliseconds
+	return "moves=" + std::to_string(latency.size()) + ' ' + latency_percentiles(latency);
+}
+
+class latencyWindow {
+public:
+	// constructor
+	latencyWindow() : _moves(0) {}
+	void add(const double milliseconds);
+	std::string summary();
+private:
+	std::mutex _mutex; // guards the members below
+	std::vector<double> _latency; // milliseconds to answer the last LATENCY_WINDOW moves (ring buffer)
+	long _moves; // moves since the start, _latency[_moves % LATENCY_WINDOW] is the next one to replace
+};
+
+void latencyWindow::add(const double milliseconds) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_latency.size() < LATENCY_WINDOW) {
+		_latency.push_back(milliseconds);
+	} else {
+		_latency[_moves % LATENCY_WINDOW] = milliseconds;
+	}
+	_moves++;
+}
+
+std::string latencyWindow::summary() {
+	// number of moves since the start, then the latency percentiles of the last window=<n> moves
+	std::vector<double> latency;
+	long moves;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		latency = _latency;
+		moves = _moves;
+	}
+	return "moves=" + std::to_string(moves) + " window=" + std::to_string(latency.size()) + ' ' + latency_percentiles(latency);
+}
+
+class workerPool {
+public:
+	// constructor: number_thread threads play the Monte Carlo paths of all the sessions
+	workerPool(const int number_thread) : _last_session(0), _stop(false) {
+		for (int i = 0; i < number_thread; i++) {
+			_threads.push_back(std::thread(&workerPool::run, this));
+		}
+	}
+	// destructor
+	~workerPool() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_wake.notify_all();
+		for (std::thread &t : _threads) {
+			t.join();
+		}
+	}
+	std::future<std::vector<bool>> submit(const int session_id, const std::function<std::vector<bool>()> job);
+	int queue_depth(const int session_id);
+	int queue_depth();
+private:
+	std::mutex _mutex; // guards _queues, _last_session and _stop
+	std::condition_variable _wake;
+	std::map<int, std::deque<std::shared_ptr<std::packaged_task<std::vector<bool>()>>>> _queues; // pending jobs, per session
+	int _last_session; // session of the last job started
+	bool _stop;
+	std::vector<std::thread> _threads;
+	void run();
+};
+
+std::future<std::vector<bool>> workerPool::submit(const int session_id, const std::function<std::vector<bool>()> job) {
+	// queue a job of session_id, and return its result to come
+	auto task = std::make_shared<std::packaged_task<std::vector<bool>()>>(job);
+	std::future<std::vector<bool>> result = task->get_future();
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queues[session_id].push_back(task);
+	}
+	_wake.notify_one();
+	return result;
+}
+
+int workerPool::queue_depth(const int session_id) {
+	// number of pending jobs of session_id
+	std::lock_guard<std::mutex> lock(_mutex);
+	const auto queue = _queues.find(session_id);
+	return (queue == _queues.end()) ? 0 : queue->second.size();
+}
+
+int workerPool::queue_depth() {
+	// number of pending jobs of all the sessions
+	std::lock_guard<std::mutex> lock(_mutex);
+	int depth = 0;
+	for (const auto &queue : _queues) {
+		depth += queue.second.size();
+	}
+	return depth;
+}
+
+void workerPool::run() {
+	// worker thread: the sessions with pending jobs are served in turn (round robin),
+	// so that a session with many jobs does not delay the others
+	while (true) {
+		std::shared_ptr<std::packaged_task<std::vector<bool>()>> task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [this] {return _stop or not _queues.empty();});
+			if (_stop) {return;}
+			auto queue = _queues.upper_bound(_last_session);
+			if (queue == _queues.end()) {
+				queue = _queues.begin();
+			}
+			task = queue->second.front();
+			queue->second.pop_front();
+			_last_session = queue->first;
+			if (queue->second.empty()) {
+				_queues.erase(queue);
+			}
+		}
+		(*task)();
+	}
+}
+
+class hexSession {
+public:
+	// constructor
+	hexSession(const int id, const bool use_pie_rule, const piece first_player)
+	: _id(id), _use_pie_rule(use_pie_rule), _move_X(BOARD_DIMENSION), _move_O(BOARD_DIMENSION), _turn(first_player), _winner(piece::EMPTY) {}
+	// helper function prototypes
+	std::string play_X(const int square_num, workerPool &pool);
+	std::string play_O(workerPool &pool);
+	std::string board();
+	inline void add_latency(const double milliseconds) {_latency.add(milliseconds);}
+	inline std::string latency_summary() {return _latency.summary();}
+private:
+	const int _id;
+	hexGraph _hex; // board of the game
+	const bool _use_pie_rule;
+	nodenumber _move_X; // first move of X, BOARD_DIMENSION until X has played
+	nodenumber _move_O; // first move of O, BOARD_DIMENSION until O has played
+	piece _turn; // player to play
+	piece _winner;
+	std::mutex _mutex; // one move at a time
+	search_stats _stats; // paths of the computer moves
+	latencyWindow _latency; // time to answer the moves of the session
+	std::string computer_turn(workerPool &pool, const std::string &played_X, const std::string &pie);
+};
+
+std::string hexSession::play_X(const int square_num, workerPool &pool) {
+	// player [X] plays square_num, then computer [O] answers
+	// reply: PLAYED <X move> <O move> <O score> <pie rule used by X or O> <winner>, '-' when not applicable
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_winner != piece::EMPTY) {return "ERROR game over";}
+	if (_turn != piece::X) {return "ERROR not player X turn";}
+	if (square_num < 0 or square_num >= BOARD_DIMENSION) {return "ERROR illegal move";}
+	nodenumber move_X = square_num;
+	std::string pie = "-";
+	const bool pie_rule = _use_pie_rule and (_move_X == BOARD_DIMENSION) and (_move_O < BOARD_DIMENSION);
+	if (pie_rule and move_X == _move_O) {
+		if (PIE_RULE_SYMMETRY) {
+			move_X = transpose_node(move_X);
+		}
+		_hex.unmake_move(_move_O);
+		pie = "X";
+	} else if (not _hex.check_move(move_X)) {
+		return "ERROR illegal move";
+	}
+	_hex.make_move(move_X, piece::X);
+	_move_X = move_X;
+	if (_hex.is_winner(piece::X)) {
+		_winner = piece::X;
+		return "PLAYED " + std::to_string((int) move_X) + " - - " + pie + " X";
+	}
+	_turn = piece::O;
+	return computer_turn(pool, std::to_string((int) move_X), pie);
+}
+
+std::string hexSession::play_O(workerPool &pool) {
+	// computer [O] plays (when computer [O] starts the game)
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_winner != piece::EMPTY) {return "ERROR game over";}
+	if (_turn != piece::O) {return "ERROR not computer O turn";}
+	return computer_turn(pool, "-", "-");
+}
+
+std::string hexSession::computer_turn(workerPool &pool, const std::string &played_X, const std::string &pie) {
+	// same choice as play_computer_turn(), but the chunks of paths are jobs of the shared pool,
+	// and the uniform allocation is split in SERVER_ROUNDS rounds: no new round is started once SESSION_TIME_BUDGET is spent
+	const bool pie_rule = _use_pie_rule and (_move_X < BOARD_DIMENSION) and (_move_O == BOARD_DIMENSION);
+	const bool play_average = _use_pie_rule and (_move_X == BOARD_DIMENSION) and (_move_O == BOARD_DIMENSION);
+	const path_executor execute = [&](std::vector<assessment> &batch) {
+		std::vector<std::future<std::vector<bool>>> results;
+		for (const assessment &a : batch) {
+			for (int k = 0; k < NUMBER_PROCESSOR; k++) {
+				results.push_back(pool.submit(_id, std::bind(&hexGraph::random_paths, a.position, chunk_seed(a.seed, k), a.number_path, a.move, COMMON_RANDOM, nullptr)));
+			}
+		}
+		size_t r = 0;
+		for (assessment &a : batch) {
+			for (int k = 0; k < NUMBER_PROCESSOR; k++) {
+				const std::vector<bool> out = results[r++].get();
+				a.outcomes.insert(a.outcomes.end(), out.begin(), out.end());
+			}
+		}
+	};
+	const auto start = std::chrono::steady_clock::now();
+	const std::function<bool()> keep_going = [&] {
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() <= SESSION_TIME_BUDGET;
+	};
+	double score_O;
+	bool pie_rule_used;
+	const nodenumber best_move = search_move(_hex, _move_X, pie_rule, play_average, execute, SERVER_ROUNDS, keep_going, time(0) + _id * 7919u, score_O, pie_rule_used, _stats);
+	std::string pie_O = pie;
+	if (pie_rule_used) {
+		pie_O = "O";
+		_hex.unmake_move(_move_X);
+	}
+	_hex.make_move(best_move, piece::O);
+	_move_O = best_move;
+	std::string winner = "-";
+	if (_hex.is_winner(piece::O)) {
+		_winner = piece::O;
+		winner = "O";
+	} else {
+		_turn = piece::X;
+	}
+	std::ostringstream reply;
+	reply << "PLAYED " << played_X << ' ' << (int) best_move << ' ' << (int) (1000. * score_O) / 10. << ' ' << pie_O << ' ' << winner;
+	return reply.str();
+}
+
+std::string hexSession::board() {
+	// board as BOARD_DIMENSION characters '.', 'X' or 'O', row after row
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _hex.get_position();
+}
+
+class hexServer {
+public:
+	// constructor
+	hexServer() : _pool(NUMBER_PROCESSOR), _next_id(1), _rejected(0), _connections(0), _refused(0) {}
+	void serve(const socket_t listener);
+private:
+	workerPool _pool; // shared by all the sessions
+	std::mutex _mutex; // guards the members below
+	std::map<int, std::shared_ptr<hexSession>> _sessions;
+	int _next_id;
+	long _rejected; // sessions refused by admission control
+	int _connections; // open connections
+	long _refused; // connections refused by admission control
+	latencyWindow _latency; // time to answer the moves of all sessions
+	void connection(const socket_t s);
+	std::string command(const std::string &line, std::set<int> &owned);
+};
+
+void hexServer::serve(const socket_t listener) {
+	// accept connections forever, one thread per connection
+	while (true) {
+		const socket_t s = accept(listener, nullptr, nullptr);
+		if (s == INVALID_SOCKET) {continue;}
+		socket_nodelay(s);
+		{
+			// above MAX_CONNECTIONS, the connection is refused like a session above MAX_SESSIONS
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_connections >= MAX_CONNECTIONS) {
+				_refused++;
+				send_line(s, "ERROR busy");
+				closesocket(s);
+				continue;
+			}
+			_connections++;
+		}
+		std::thread(&hexServer::connection, this, s).detach();
+	}
+}
+
+void hexServer::connection(const socket_t s) {
+	// answer the commands of a connection, one line each, until QUIT or disconnection
+	// the sessions created by the connection and still open are closed with it
+	std::string buffer;
+	std::string line;
+	std::set<int> owned;
+	while (receive_line(s, buffer, line)) {
+		if (line == "QUIT") {break;}
+		if (not send_line(s, command(line, owned))) {break;}
+	}
+	closesocket(s);
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (const int id : owned) {
+		_sessions.erase(id);
+	}
+	_connections--;
+}
+
+std::string hexServer::command(const std::string &line, std::set<int> &owned) {
+	// NEW [YES/NO pie rule] [X/O first player]  -> OK <session>, or ERROR busy above MAX_SESSIONS
+	// X <session> <square>                      -> player [X] move, and computer [O] answer
+	// O <session>                               -> computer [O] move
+	// BOARD <session>                           -> BOARD <squares>
+	// STATS [<session>]                         -> queue depth & move latency percentiles (last LATENCY_WINDOW moves)
+	// CLOSE <session>                           -> OK
+	std::istringstream in(line);
+	std::string name;
+	in >> name;
+	std::ostringstream reply;
+	if (name == "NEW") {
+		std::string pie_rule = "YES";
+		std::string first_player = "X";
+		in >> pie_rule >> first_player;
+		std::lock_guard<std::mutex> lock(_mutex);
+		if ((int) _sessions.size() >= MAX_SESSIONS) {
+			_rejected++;
+			return "ERROR busy";
+		}
+		const int id = _next_id++;
+		_sessions[id] = std::make_shared<hexSession>(id, pie_rule != "NO", (first_player == "O") ? piece::O : piece::X);
+		owned.insert(id);
+		reply << "OK " << id;
+		return reply.str();
+	}
+	int id;
+	if (not (in >> id)) {
+		if (name == "STATS") {
+			std::lock_guard<std::mutex> lock(_mutex);
+			reply << "STATS sessions=" << _sessions.size() << '/' << MAX_SESSIONS << " rejected=" << _rejected;
+			reply << " connections=" << _connections << '/' << MAX_CONNECTIONS << " refused=" << _refused;
+			reply << " queue=" << _pool.queue_depth() << ' ' << _latency.summary();
+			return reply.str();
+		}
+		return "ERROR syntax";
+	}
+	// a connection only sees its own sessions
+	if (owned.count(id) == 0) {return "ERROR unknown session";}
+	std::shared_ptr<hexSession> session;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		const auto found = _sessions.find(id);
+		if (found == _sessions.end()) {return "ERROR unknown session";}
+		session = found->second;
+		if (name == "CLOSE") {
+			_sessions.erase(found);
+			owned.erase(id);
+			return "OK";
+		}
+	}
+	if (name == "X" or name == "O") {
+		int square_num = BOARD_DIMENSION;
+		if (name == "X" and not (in >> square_num)) {return "ERROR syntax";}
+		const auto start = std::chrono::steady_clock::now();
+		const std::string played = (name == "X") ? session->play_X(square_num, _pool) : session->play_O(_pool);
+		if (played.compare(0, 7, "PLAYED ") == 0) {
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			session->add_latency(elapsed.count());
+			_latency.add(elapsed.count());
+		}
+		return played;
+	}
+	if (name == "BOARD") {
+		return "BOARD " + session->board();
+	}
+	if (name == "STATS") {
+		reply << "STATS " << id << " queue=" << _pool.queue_depth(id) << ' ' << session->latency_summary();
+		return reply.str();
+	}
+	return "ERROR unknown command";
+}
+
+int run_server(int argc, char ** argv) {
+	// hex SERVER <address> <board_size> <monte_carlo> <processors> <max_sessions> <time_budget> <common_random> <allocation> <max_connections>
+	const std::string address = (argc >= 3) ? argv[2] : "7011";
+	if (argc >= 4) {BOARD_SIZE = std::atoi(argv[3]);}
+	if (BOARD_SIZE < 3) {BOARD_SIZE = 3;}
+	if (BOARD_SIZE > MAX_BOARD_SIZE) {BOARD_SIZE = MAX_BOARD_SIZE;}
+	BOARD_DIMENSION = BOARD_SIZE * BOARD_SIZE;
+	if (argc >= 5) {NUMBER_MONTE_CARLO_PATH = std::atoi(argv[4]);}
+	if (NUMBER_MONTE_CARLO_PATH < 100) {NUMBER_MONTE_CARLO_PATH = 100;}
+	if (argc >= 6) {NUMBER_PROCESSOR = std::atoi(argv[5]);}
+	if (NUMBER_PROCESSOR < 1) {NUMBER_PROCESSOR = 1;}
+	NUMBER_MONTE_CARLO_PATH = NUMBER_MONTE_CARLO_PATH / NUMBER_PROCESSOR;
+	if (argc >= 7) {MAX_SESSIONS = std::atoi(argv[6]);}
+	if (MAX_SESSIONS < 1) {MAX_SESSIONS = 1;}
+	MAX_CONNECTIONS = 2 * MAX_SESSIONS;
+	if (argc >= 8) {SESSION_TIME_BUDGET = std::atof(argv[7]);}
+	if (argc >= 9) {const std::string str(argv[8]); COMMON_RANDOM = (str == "YES");}
+	if (argc >= 10) {const std::string str(argv[9]); MOVE_ALLOCATION = (str == "HALVING") ? allocation::HALVING : (str == "COMPARE") ? allocation::COMPARE : allocation::UNIFORM;}
+	if (argc >= 11) {MAX_CONNECTIONS = std::atoi(argv[10]);}
+	if (MAX_CONNECTIONS < 1) {MAX_CONNECTIONS = 1;}
+	socket_startup();
+	const socket_t listener = socket_open(address, true);
+	if (listener == INVALID_SOCKET) {
+		std::cout << "Cannot listen on " << address << std::endl;
+		return 1;
+	}
+	std::cout << "Hex server listening on " << address << ": board size = " << (int) BOARD_SIZE;
+	std::cout << ", processors = " << NUMBER_PROCESSOR << ", max sessions = " << MAX_SESSIONS << ", max connections = " << MAX_CONNECTIONS;
+	std::cout << ", time budget = " << SESSION_TIME_BUDGET << " seconds" << std::endl;
+	hexServer server;
+	server.serve(listener);
+	return 0;
+}
+
+struct load_result {
+	bool connected = false;
+	bool rejected = false; // refused by admission control
+	int errors = 0;
+	std::vector<double> latency; // milliseconds per move, as seen by the client
+};
+
+void load_client(const std::string &address, const int number_move, const unsigned int seed, load_result *result) {
+	// play number_move random moves as player [X] in one session (a new game starts when a game is over)
+	std::mt19937 generator(seed);
+	const socket_t s = socket_open(address, false);
+	if (s == INVALID_SOCKET) {return;}
+	result->connected = true;
+	std::string buffer;
+	std::string line;
+	int id = 0;
+	bool computer_to_play = false;
+	for (int i = 0; i < number_move; i++) {
+		if (id == 0) {
+			// new game, random pie rule and first player
+			const bool pie_rule = generator() % 2;
+			computer_to_play = generator() % 2;
+			if (not send_line(s, std::string("NEW ") + (pie_rule ? "YES" : "NO") + (computer_to_play ? " O" : " X"))) {break;}
+			if (not receive_line(s, buffer, line)) {break;}
+			if (line.compare(0, 3, "OK ") != 0) {
+				result->rejected = true;
+				break;
+			}
+			id = std::atoi(line.c_str() + 3);
+		}
+		std::string request = "O " + std::to_string(id);
+		if (not computer_to_play) {
+			// random empty square
+			if (not send_line(s, "BOARD " + std::to_string(id))) {break;}
+			if (not receive_line(s, buffer, line)) {break;}
+			std::vector<int> empty;
+			for (size_t n = 6; n < line.size(); n++) {
+				if (line[n] == '.') {empty.push_back(n - 6);}
+			}
+			if (empty.empty()) {break;}
+			request = "X " + std::to_string(id) + ' ' + std::to_string(empty[generator() % empty.size()]);
+		}
+		const auto start = std::chrono::steady_clock::now();
+		if (not send_line(s, request)) {break;}
+		if (not receive_line(s, buffer, line)) {break;}
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		result->latency.push_back(elapsed.count());
+		computer_to_play = false;
+		if (line.compare(0, 7, "PLAYED ") != 0) {
+			result->errors++;
+		} else if (line.back() != '-') {
+			// game over
+			send_line(s, "CLOSE " + std::to_string(id));
+			receive_line(s, buffer, line);
+			id = 0;
+		}
+	}
+	if (id != 0) {
+		send_line(s, "CLOSE " + std::to_string(id));
+		receive_line(s, buffer, line);
+	}
+	closesocket(s);
+}
+
+int run_load_generator(int argc, char ** argv) {
+	// hex LOADGEN <address> <clients> <moves_per_client>
+	const std::string address = (argc >= 3) ? argv[2] : "7011";
+	const int number_client = (argc >= 4) ? std::max(1, std::atoi(argv[3])) : 8;
+	const int number_move = (argc >= 5) ? std::max(1, std::atoi(argv[4])) : 10;
+	socket_startup();
+	std::vector<load_result> results(number_client);
+	std::vector<std::thread> clients;
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < number_client; i++) {
+		clients.push_back(std::thread(load_client, address, number_move, (unsigned int) time(0) + i, &results[i]));
+	}
+	for (std::thread &t : clients) {
+		t.join();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	int connected = 0;
+	int rejected = 0;
+	int errors = 0;
+	std::vector<double> latency;
+	for (const load_result &result : results) {
+		if (result.connected) {connected++;}
+		if (result.rejected) {rejected++;}
+		errors += result.errors;
+		latency.insert(latency.end(), result.latency.begin(), result.latency.end());
+	}
+	std::cout << "Clients   : " << connected << " connected of " << number_client << ", " << rejected << " rejected (admission control)" << std::endl;
+	std::cout << "Moves     : " << latency.size() << " in " << (int) (10. * elapsed.count()) / 10. << " seconds";
+	std::cout << " (" << (int) (100. * latency.size() / elapsed.count()) / 100. << " per second), " << errors << " errors" << std::endl;
+	std::cout << "Client    : " << latency_summary(latency) << std::endl;
+	const socket_t s = socket_open(address, false);
+	std::string buffer;
+	std::string line;
+	if (s != INVALID_SOCKET and send_line(s, "STATS") and receive_line(s, buffer, line)) {
+		std::cout << "Server    : " << line << std::endl;
+	}
+	if (s != INVALID_SOCKET) {closesocket(s);}
+	return 0;
+}
+
+std::string encode_outcomes(const std::vector<bool> &outcome) {
+	// outcomes of the paths as hexadecimal digits, 4 paths per digit
+	std::string code((outcome.size() + 3) / 4, '0');
+	for (size_t k = 0; k < code.size(); k++) {
+		int digit = 0;
+		for (size_t bit = 0; bit < 4 and 4 * k + bit < outcome.size(); bit++) {
+			if (outcome[4 * k + bit]) {digit |= 1 << bit;}
+		}
+		code[k] = "0123456789abcdef"[digit];
+	}
+	return code;
+}
+
+bool decode_outcomes(const std::string &reply, const int number_path, std::vector<bool> &outcome) {
+	// outcomes of the paths from a worker reply: WINS <number of wins> <encode_outcomes()>
+	// return false if the reply is not valid
+	std::istringstream in(reply);
+	std::string name;
+	long count_win;
+	std::string code;
+	if (not (in >> name >> count_win >> code) or name != "WINS" or code.size() != (size_t) (number_path + 3) / 4) {return false;}
+	outcome.assign(number_path, false);
+	for (int k = 0; k < number_path; k++) {
+		const size_t digit = std::string("0123456789abcdef").find(code[k / 4]);
+		if (digit == std::string::npos) {return false;}
+		outcome[k] = (digit >> (k % 4)) & 1;
+	}
+	return (std::count(outcome.begin(), outcome.end(), true) == count_win);
+}
+
+class playoutCoordinator {
+public:
+	// helper function prototypes
+	void run(const hexGraph &hex, const nodenumber move, const unsigned int seed, const int number_path, std::vector<std::vector<bool>> &out);
+	std::string summary();
+private:
+	struct worker {
+		std::string address;
+		socket_t s; // INVALID_SOCKET until connected, and after a failure
+		std::string buffer; // received after the last reply
+		int suspended; // number of next runs without this worker
+	};
+	std::vector<worker> _workers;
+	std::mutex _mutex; // guards the members below
+	std::condition_variable _changed;
+	// current run: chunk k is played with the seed chunk_seed(seed, k), like thread k in assess_move()
+	std::vector<std::vector<bool>> *_out;
+	std::vector<bool> _done;
+	std::vector<int> _running; // number of workers playing each chunk
+	std::vector<std::chrono::steady_clock::time_point> _started; // first dispatch of each chunk
+	int _remaining; // chunks not done
+	std::chrono::steady_clock::time_point _deadline;
+	double _chunk_seconds = 0.; // time of the chunks completed during the run
+	int _completed = 0;
+	double _path_seconds = 0.; // moving average of the time per path of the chunks completed by the workers, 0 until known
+	// statistics
+	long _remote = 0; // chunks played by the workers
+	long _redispatched = 0; // chunks sent again to another worker (slow or dead worker)
+	long _failures = 0; // lost connections & invalid replies
+	long _local = 0; // chunks played locally after the deadline
+	long _suspensions = 0; // workers left out of the next runs
+	int next_chunk();
+	void suspend(worker &wk);
+	void work(const size_t w, const std::string &position, const nodenumber move, const unsigned int seed, const int number_path);
+};
+
+playoutCoordinator COORDINATOR;
+
+void playoutCoordinator::run(const hexGraph &hex, const nodenumber move, const unsigned int seed, const int number_path, std::vector<std::vector<bool>> &out) {
+	// play out.size() chunks of number_path paths, one thread per worker process
+	// the chunks still missing at the deadline (all workers dead or too slow) are played locally
+	if (_workers.size() != PLAYOUT_WORKERS.size()) {
+		for (worker &wk : _workers) {
+			if (wk.s != INVALID_SOCKET) {closesocket(wk.s);}
+		}
+		_workers.clear();
+		for (const std::string &address : PLAYOUT_WORKERS) {
+			_workers.push_back({address, INVALID_SOCKET, "", 0});
+		}
+	}
+	std::vector<size_t> active;
+	for (size_t w = 0; w < _workers.size(); w++) {
+		if (_workers[w].suspended > 0) {
+			_workers[w].suspended--;
+		} else {
+			active.push_back(w);
+		}
+	}
+	const std::string position = hex.get_position();
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_out = &out;
+		_done.assign(out.size(), false);
+		_running.assign(out.size(), 0);
+		_started.assign(out.size(), std::chrono::steady_clock::now());
+		_remaining = out.size();
+		// the deadline follows the time per path of the workers: rounds of chunks played in parallel by the active workers
+		double deadline = WORKER_DEADLINE;
+		if (_path_seconds > 0. and not active.empty()) {
+			const int rounds = (out.size() + active.size() - 1) / active.size();
+			deadline = std::max(WORKER_DEADLINE_FLOOR, WORKER_DEADLINE_FACTOR * _path_seconds * number_path * rounds);
+		}
+		_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds((long) (1000. * deadline));
+		_chunk_seconds = 0.;
+		_completed = 0;
+	}
+	std::vector<std::thread> threads;
+	for (const size_t w : active) {
+		threads.push_back(std::thread(&playoutCoordinator::work, this, w, position, move, seed, number_path));
+	}
+	for (std::thread &t : threads) {
+		t.join();
+	}
+	// missing chunks, one thread each like assess_move()
+	threads.clear();
+	for (size_t k = 0; k < out.size(); k++) {
+		if (not _done[k]) {
+			threads.push_back(std::thread([&hex, &out, k, move, seed, number_path] {
+				hexGraph local = hex;
+				out[k] = local.random_paths(chunk_seed(seed, k), number_path, move, COMMON_RANDOM);
+			}));
+			_local++;
+		}
+	}
+	for (std::thread &t : threads) {
+		t.join();
+	}
+}
+
+void playoutCoordinator::suspend(worker &wk) {
+	// leave the worker out of the next runs (_mutex locked), and reconnect afterwards
+	if (wk.s != INVALID_SOCKET) {
+		closesocket(wk.s);
+		wk.s = INVALID_SOCKET;
+	}
+	wk.suspended = WORKER_SUSPENDED_RUNS;
+	_suspensions++;
+}
+
+int playoutCoordinator::next_chunk() {
+	// chunk for an idle worker (_mutex locked): a chunk nobody plays,
+	// or else a chunk running for much longer than the chunks completed so far
+	// return -1 if there is none
+	for (size_t k = 0; k < _done.size(); k++) {
+		if (not _done[k] and _running[k] == 0) {return k;}
+	}
+	if (_completed > 0) {
+		const auto now = std::chrono::steady_clock::now();
+		for (size_t k = 0; k < _done.size(); k++) {
+			const std::chrono::duration<double> running_time = now - _started[k];
+			if (not _done[k] and _running[k] == 1 and running_time.count() > REDISPATCH_FACTOR * _chunk_seconds / _completed) {return k;}
+		}
+	}
+	return -1;
+}
+
+void playoutCoordinator::work(const size_t w, const std::string &position, const nodenumber move, const unsigned int seed, const int number_path) {
+	// send chunks to the worker process w until all the chunks are done, the deadline, or a failure of the worker
+	worker &wk = _workers[w];
+	if (wk.s == INVALID_SOCKET) {
+		// an unreachable host must not hold the run (_deadline is set before the threads start)
+		const std::chrono::duration<double, std::milli> time_left = _deadline - std::chrono::steady_clock::now();
+		wk.s = socket_open(wk.address, false, std::max(0, (int) std::min(time_left.count(), 1000. * WORKER_CONNECT_TIMEOUT)));
+		wk.buffer.clear();
+	}
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (wk.s == INVALID_SOCKET) {
+		_failures++;
+		suspend(wk);
+	}
+	while (wk.s != INVALID_SOCKET and _remaining > 0 and std::chrono::steady_clock::now() < _deadline) {
+		const int chunk = next_chunk();
+		if (chunk < 0) {
+			// all the chunks are done or running: wait until one of them may need a backup
+			_changed.wait_for(lock, std::chrono::milliseconds(10));
+			continue;
+		}
+		if (_running[chunk] == 0) {
+			_started[chunk] = std::chrono::steady_clock::now();
+		} else {
+			_redispatched++;
+		}
+		_running[chunk]++;
+		lock.unlock();
+		const auto dispatched = std::chrono::steady_clock::now();
+		std::ostringstream request;
+		request << "PATHS " << (int) BOARD_SIZE << ' ' << position << ' ' << (int) move << ' ' << chunk_seed(seed, chunk) << ' ' << number_path << ' ' << (COMMON_RANDOM ? "YES" : "NO");
+		int received = (send_line(wk.s, request.str())) ? 0 : -1;
+		std::string reply;
+		while (received == 0) {
+			received = receive_line_wait(wk.s, wk.buffer, reply, 10);
+			if (received == 0) {
+				// stop waiting once another worker did the chunk, or at the deadline
+				std::lock_guard<std::mutex> check(_mutex);
+				if (_done[chunk] or std::chrono::steady_clock::now() >= _deadline) {break;}
+			}
+		}
+		std::vector<bool> outcome;
+		const bool valid = (received == 1 and decode_outcomes(reply, number_path, outcome));
+		lock.lock();
+		_running[chunk]--;
+		if (valid) {
+			if (not _done[chunk]) {
+				_done[chunk] = true;
+				(*_out)[chunk] = outcome;
+				_remaining--;
+				_remote++;
+				const std::chrono::duration<double> chunk_time = std::chrono::steady_clock::now() - dispatched;
+				_chunk_seconds += chunk_time.count();
+				_completed++;
+				const double path_seconds = chunk_time.count() / number_path;
+				_path_seconds = (_path_seconds > 0.) ? 0.8 * _path_seconds + 0.2 * path_seconds : path_seconds;
+			}
+		} else if (received == 0 and _done[chunk]) {
+			// abandoned reply, the chunk was done by another worker: a late reply would mix up the next requests,
+			// so reconnect at the next run
+			closesocket(wk.s);
+			wk.s = INVALID_SOCKET;
+		} else {
+			// lost or invalid reply, or still no reply at the deadline
+			if (received != 0) {_failures++;}
+			suspend(wk);
+		}
+		_changed.notify_all();
+	}
+	_changed.notify_all();
+}
+
+std::string playoutCoordinator::summary() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::ostringstream out;
+	out << "workers=" << PLAYOUT_WORKERS.size() << " remote=" << _remote << " redispatched=" << _redispatched;
+	out << " failures=" << _failures << " suspensions=" << _suspensions << " local=" << _local;
+	return out.str();
+}
+
+void distributed_paths(const hexGraph &hex, const nodenumber move, const unsigned int seed, const int number_path, std::vector<std::vector<bool>> &out) {
+	COORDINATOR.run(hex, move, seed, number_path, out);
+}
+
+std::string worker_reply(const std::string &request, const std::function<bool()> &stop) {
+	// PATHS <board_size> <position> <move> <seed> <number_path> <common_random>  ->  WINS <number of wins> <encode_outcomes()>
+	// the board size & common_random are those of the request, not those of the worker process
+	// return an empty reply if stop() abandons the paths
+	std::istringstream in(request);
+	std::string name;
+	int board_size;
+	std::string position;
+	int move;
+	unsigned int seed;
+	int number_path;
+	std::string common_random;
+	if (not (in >> name >> board_size >> position >> move >> seed >> number_path >> common_random) or name != "PATHS") {return "ERROR syntax";}
+	if (board_size < 3 or board_size > MAX_BOARD_SIZE or move < 0 or move >= board_size * board_size or number_path < 1) {return "ERROR syntax";}
+	hexGraph hex(board_size);
+	// move is the O square being assessed
+	if (not hex.set_position(position) or position[move] != 'O') {return "ERROR position";}
+	const std::vector<bool> outcome = hex.random_paths(seed, number_path, move, common_random == "YES", stop);
+	if ((int) outcome.size() < number_path) {return "";}
+	std::ostringstream reply;
+	reply << "WINS " << std::count(outcome.begin(), outcome.end(), true) << ' ' << encode_outcomes(outcome);
+	return reply.str();
+}
+
+std::atomic<int> WORKER_CONNECTIONS(0); // open connections of the worker process
+
+void worker_connection(const socket_t s) {
+	// answer the requests of a coordinator until disconnection
+	std::string buffer;
+	std::string line;
+	// a coordinator closes the connection of a chunk it no longer waits for (played locally or by another worker)
+	const std::function<bool()> abandoned = [s]() {return socket_closed(s);};
+	while (receive_line(s, buffer, line)) {
+		const std::string reply = worker_reply(line, abandoned);
+		if (reply.empty() or not send_line(s, reply)) {break;}
+	}
+	closesocket(s);
+	WORKER_CONNECTIONS--;
+}
+
+int run_worker(int argc, char ** argv) {
+	// hex WORKER <address>
+	// one worker process plays one chunk at a time: start one worker process per core
+	const std::string address = (argc >= 3) ? argv[2] : "7101";
+	socket_startup();
+	const socket_t listener = socket_open(address, true);
+	if (listener == INVALID_SOCKET) {
+		std::cout << "Cannot listen on " << address << std::endl;
+		return 1;
+	}
+	std::cout << "Hex worker listening on " << address << std::endl;
+	while (true) {
+		const socket_t s = accept(listener, nullptr, nullptr);
+		if (s == INVALID_SOCKET) {continue;}
+		socket_nodelay(s);
+		// above MAX_WORKER_CONNECTIONS, the coordinator gets an invalid reply and plays elsewhere
+		if (WORKER_CONNECTIONS >= MAX_WORKER_CONNECTIONS) {
+			send_line(s, "ERROR busy");
+			closesocket(s);
+			continue;
+		}
+		WORKER_CONNECTIONS++;
+		std::thread(worker_connection, s).detach();
+	}
+	return 0;
+}
+
+std::vector<std::string> split_addresses(const std::string &addresses) {
+	// comma separated addresses, none for "NO"
+	std::vector<std::string> out;
+	if (addresses == "NO") {return out;}
+	std::istringstream in(addresses);
+	std::string address;
+	while (std::getline(in, address, ',')) {
+		if (not address.empty()) {out.push_back(address);}
+	}
+	return out;
+}
+
+int run_benchmark(int argc, char ** argv) {
+	// hex BENCH <board_size> <monte_carlo> <processors> <workers> <repeat> <scaling>
+	// time the assessment of a move on an empty board, by the local threads (workers = NO) or by the worker processes;
+	// with scaling = YES, by the first 1, 2, 4, 8... workers of the list
+	if (argc >= 3) {BOARD_SIZE = std::atoi(argv[2]);}
+	if (BOARD_SIZE < 3) {BOARD_SIZE = 3;}
+	if (BOARD_SIZE > MAX_BOARD_SIZE) {BOARD_SIZE = MAX_BOARD_SIZE;}
+	BOARD_DIMENSION = BOARD_SIZE * BOARD_SIZE;
+	if (argc >= 4) {NUMBER_MONTE_CARLO_PATH = std::atoi(argv[3]);}
+	if (NUMBER_MONTE_CARLO_PATH < 100) {NUMBER_MONTE_CARLO_PATH = 100;}
+	if (argc >= 5) {NUMBER_PROCESSOR = std::atoi(argv[4]);}
+	if (NUMBER_PROCESSOR < 1) {NUMBER_PROCESSOR = 1;}
+	NUMBER_MONTE_CARLO_PATH = NUMBER_MONTE_CARLO_PATH / NUMBER_PROCESSOR;
+	if (argc >= 6) {PLAYOUT_WORKERS = split_addresses(argv[5]);}
+	const int repeat = (argc >= 7) ? std::max(1, std::atoi(argv[6])) : 10;
+	const bool scaling = (argc >= 8 and std::string(argv[7]) == "YES" and not PLAYOUT_WORKERS.empty());
+	socket_startup();
+	hexGraph hex;
+	hex.make_move(BOARD_DIMENSION / 2, piece::O);
+	const long paths = (long) repeat * NUMBER_MONTE_CARLO_PATH * NUMBER_PROCESSOR;
+	if (scaling) {
+		// one assessment first, to connect the workers and measure their time per path
+		const std::vector<std::string> workers = PLAYOUT_WORKERS;
+		double paths_per_second_1 = 0.;
+		for (size_t n = 1; n <= workers.size(); n *= 2) {
+			PLAYOUT_WORKERS.assign(workers.begin(), workers.begin() + n);
+			assess_move(hex, BOARD_DIMENSION / 2, 12345);
+			const auto start = std::chrono::steady_clock::now();
+			for (int r = 0; r < repeat; r++) {
+				assess_move(hex, BOARD_DIMENSION / 2, 12345 + r);
+			}
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			const double paths_per_second = paths / elapsed.count();
+			if (n == 1) {paths_per_second_1 = paths_per_second;}
+			std::cout << "Workers " << n << (n < 10 ? " " : "") << ": " << (long) paths_per_second << " paths per second";
+			std::cout << " (speedup = " << (int) (100. * paths_per_second / paths_per_second_1) / 100. << ")" << std::endl;
+		}
+		std::cout << "Workers   : " << COORDINATOR.summary() << std::endl;
+		return 0;
+	}
+	double score = 0.;
+	const auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repeat; r++) {
+		score += assess_move(hex, BOARD_DIMENSION / 2, 12345 + r);
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::cout << "Paths     : " << paths << " in " << elapsed.count() << " seconds (" << (long) (paths / elapsed.count()) << " per second)" << std::endl;
+	std::cout << "Score     : " << score / repeat << std::endl;
+	if (not PLAYOUT_WORKERS.empty()) {
+		std::cout << "Workers   : " << COORDINATOR.summary() << std::endl;
+	}
+	return 0;
+}
+
 void init_global_variables(int argc, char ** argv) {
 	// re-initialize global variables from command line
 	if (argc >= 2) {BOARD_SIZE = (int) std::atoi(argv[1]);}
@@ -639,6 +2176,10 @@ void init_global_variables(int argc, char ** argv) {
 	if (BACKGROUND_SELECT < color_black or BACKGROUND_SELECT > color_white) {BACKGROUND_SELECT = color_gray;}
 	bool DISPLAY_MODIFS = true;
 	if (argc >= 11) {const std::string str(argv[10]); DISPLAY_MODIFS = (str != "NO");}
+	if (argc >= 12) {const std::string str(argv[11]); MOVE_ALLOCATION = (str == "HALVING") ? allocation::HALVING : (str == "COMPARE") ? allocation::COMPARE : allocation::UNIFORM;}
+	if (argc >= 13) {const std::string str(argv[12]); COMMON_RANDOM = (str == "YES");}
+	if (argc >= 14) {PLAYOUT_WORKERS = split_addresses(argv[13]);}
+	if (not PLAYOUT_WORKERS.empty()) {socket_startup();}
 	if (DISPLAY_MODIFS) {
 		std::cout << "Per command line, Hex will use:\n\n";
 		std::cout << "Board size           = " << (int) BOARD_SIZE << std::endl;
@@ -650,13 +2191,21 @@ void init_global_variables(int argc, char ** argv) {
 		std::cout << "Player color [X]     = " << COLOR_X << std::endl;
 		std::cout << "Computer color [O]   = " << COLOR_O << std::endl;
 		std::cout << "Selection color      = " << BACKGROUND_SELECT << std::endl;
+		std::cout << "Move allocation      = " << ((MOVE_ALLOCATION == allocation::HALVING) ? "HALVING" : (MOVE_ALLOCATION == allocation::COMPARE) ? "COMPARE" : "UNIFORM") << std::endl;
+		std::cout << "Common random fills  = " << ((COMMON_RANDOM) ? "YES" : "NO") << std::endl;
+		std::cout << "Playout workers      = " << ((PLAYOUT_WORKERS.empty()) ? "NO" : argv[13]) << std::endl;
 		std::cout << "\nPress any key to continue..." << std::endl;
 		_getch();
-		system("cls");
+		console_clear();
 	}
 }
 
 int main(int argc, char ** argv){
+	// server mode & its load generator, playout worker process & its benchmark
+	if (argc >= 2 and std::string(argv[1]) == "SERVER") {return run_server(argc, argv);}
+	if (argc >= 2 and std::string(argv[1]) == "LOADGEN") {return run_load_generator(argc, argv);}
+	if (argc >= 2 and std::string(argv[1]) == "WORKER") {return run_worker(argc, argv);}
+	if (argc >= 2 and std::string(argv[1]) == "BENCH") {return run_benchmark(argc, argv);}
 	// update defaults
 	// argv[0] is "<path>\hex.exe"
 	if (argc >= 2) {
@@ -673,11 +2222,8 @@ int main(int argc, char ** argv){
 		return 0;
 	}
 	while (true) {
-		// create parallel board games, all equal, for parallel thread processing
-		std::vector<hexGraph> hex;
-		for (int i = 0; i < NUMBER_PROCESSOR; i++) {
-			hex.push_back(hexGraph());
-		}
+		// board of the game (each assessment thread plays its own copy)
+		hexGraph hex;
 		nodenumber move_X;
 		if (FIRST_PLAYER == piece::X ) {
 			move_X = BOARD_DIMENSION / 2; // cursor in the middle if player [X] starts
@@ -691,11 +2237,12 @@ int main(int argc, char ** argv){
 		bool pie_rule = USE_PIE_RULE;
 		bool pie_rule_was_used = false;
 		piece winner = piece::EMPTY;
+		search_stats stats;
 		while (true) {
 			// Player [X]'s turn
 			if (not (FIRST_PLAYER == piece::O and first_move)) {
 				pie_rule = USE_PIE_RULE and (move_X == BOARD_DIMENSION) and (move_O < BOARD_DIMENSION);
-				winner = play_player_turn(hex, move_O, move_X, score_O, pie_rule, pie_rule_was_used, time_O);
+				winner = play_player_turn(hex, move_O, move_X, score_O, pie_rule, pie_rule_was_used, time_O, stats);
 				if (winner == piece::X) {
 					break;
 				}
@@ -703,17 +2250,18 @@ int main(int argc, char ** argv){
 				move_X = BOARD_DIMENSION;
 			}
 			// Computer [O]'s turn
-			const clock_t time0 = clock();
+			const auto time0 = std::chrono::steady_clock::now();
 			pie_rule = USE_PIE_RULE and (move_X < BOARD_DIMENSION) and (move_O == BOARD_DIMENSION);
 			const bool play_average = USE_PIE_RULE and (move_X == BOARD_DIMENSION) and (move_O == BOARD_DIMENSION);
-			winner = play_computer_turn(hex, move_O, move_X, score_O, pie_rule, pie_rule_was_used, play_average);
+			winner = play_computer_turn(hex, move_O, move_X, score_O, pie_rule, pie_rule_was_used, play_average, stats);
 			if (winner == piece::O) {
 				break;
 			}
 			first_move = false;
-			time_O = float(clock() - time0) / 1000.;
+			const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - time0;
+			time_O = elapsed.count();
 		}
-		hex[0].print(hex[0].victory_path(winner), winner);
+		hex.print(hex.victory_path(winner), winner);
 		std::cout << " ******** GAME OVER ********";
 		erase_end_line();
 		if (winner == piece::O) {